@@ -28,6 +28,123 @@
 
 #define SSD1306_CONTROL_BYTE_DATA        0x40
 #define SSD1306_CONTROL_BYTE_COMMAND     0x00
+#define SSD1306_CONTROL_BYTE_NONE        0xFF    // driver only, buffer starts with its control byte
+
+#define SSD1306_I2C_TIMEOUT             50      // ms, blocking transfer, whole frame takes ~25 ms at 400 kHz
+
+// Bus recovery pins, same as I2C1 in CubeMX
+#define SSD1306_SCL_PORT                GPIOB
+#define SSD1306_SCL_PIN                 GPIO_PIN_6
+#define SSD1306_SDA_PORT                GPIOB
+#define SSD1306_SDA_PIN                 GPIO_PIN_7
+#define SSD1306_RECOVERY_DELAY          200     // busy loop count, half SCL period
+
+
+/* SSD1306 Option */
+
+// Non-blocking transfer (choose one, default : blocking)
+// IT  : enable I2C1 event/error interrupt in CubeMX
+// DMA : add I2C1_TX DMA request in CubeMX
+// Call ssd1306_i2c_tx_cplt_callback() in HAL_I2C_MemTxCpltCallback()
+// Call ssd1306_i2c_error_callback() in HAL_I2C_ErrorCallback()
+//#define SSD1306_USE_IT
+//#define SSD1306_USE_DMA
+
+// Sleep with WFI while waiting for IT/DMA transfers
+// ssd1306_sleep_begin()/ssd1306_sleep_end() hooks may lower the clock, keep PCLK1 unchanged for I2C
+//#define SSD1306_USE_SLEEP
+
+// frame_sleep_time in ssd1306_get_stats(), init sets DBGMCU_CR.DBG_SLEEP so CYCCNT counts in WFI
+// HCLK then stays on in sleep and only the CPU stops, for measurements, not for low power builds
+//#define SSD1306_USE_SLEEP_STATS
+
+// Buffer fill and copy on DMA2 memory-to-memory stream, default : CPU word loop
+// Call ssd1306_m2m_dma_irq_handler() in the stream IRQ handler and enable its NVIC line
+//#define SSD1306_USE_M2M_DMA
+#define SSD1306_M2M_DMA_STREAM          DMA2_Stream0
+
+// Zero-copy frame : control byte slot right before the buffer
+// Whole frame goes to HAL_I2C_Master_Transmit(_DMA) as is, no memory address phase
+// Also call ssd1306_i2c_tx_cplt_callback() in HAL_I2C_MasterTxCpltCallback()
+//#define SSD1306_USE_ZERO_COPY
+
+// Frame memory comes from ssd1306_attach_frame() only, saves the internal SSD1306_FRAME_SIZE bytes
+//#define SSD1306_USE_EXTERNAL_BUFFER
+
+// Page streaming : one page of frame memory (128 bytes instead of 1 KB)
+// ssd1306_stream_frame() runs the draw callback once per page and sends each page when drawn
+// Whole-buffer flushes (update_screen, region, dirty) return HAL_ERROR
+//#define SSD1306_USE_PAGE_STREAMING
+
+// Dirty tile flush, one 32-bit CRC per tile of the last sent frame instead of a 1 KB shadow copy
+// Without it ssd1306_update_screen_dirty() sends the whole frame and the tables below take no RAM
+//#define SSD1306_USE_DIRTY_CRC
+
+// RAM : 4 bytes per tile for CRCs, 6 bytes per possible run of changed tiles for queued windows
+// 16 : 64 tiles, 256 + 192 = 448 bytes / 128 : one tile per page, 32 + 48 = 80 bytes
+// Multiple of 4 (CRC over 32-bit words) that divides 128
+#define SSD1306_DIRTY_TILE_WIDTH        16
+
+// Run render kernels and glyph blitters from SRAM, no flash wait states at FLASH_LATENCY_3
+// Startup copies the .ssd1306_ramfunc section with .data, see STM32F411CEUX_FLASH.ld
+//#define SSD1306_USE_RAMFUNC
+
+// Pixel writes through the Cortex-M3/M4 SRAM bit-band alias, one word access per pixel, no mask
+// Frame buffer must be in 0x20000000 - 0x200FFFFF, other cores keep the mask code
+// Only the pixel store of ssd1306_white_pixel() / ssd1306_black_pixel() is atomic, the lit count is recounted on read
+// Raster op, line, glyph and bitmap writers (ssd1306_rop_byte(), ssd1306_rop_run()) stay byte read-modify-writes, not ISR-safe
+//#define SSD1306_USE_BITBAND
+
+// Nested clip rectangles, the whole panel takes the first level
+#define SSD1306_CLIP_DEPTH              4
+
+// Pending non-blocking transfers, one slot always stays free
+#define SSD1306_TRANSFER_QUEUE_SIZE     16
+
+// ms between ssd1306_heartbeat() register refreshes, 0 : disable
+#define SSD1306_HEARTBEAT_PERIOD        1000
+
+// Detached mode : consecutive failed transfers before all writes become no-op
+// ssd1306_heartbeat() re-probes every SSD1306_REPROBE_PERIOD ms
+#define SSD1306_FAIL_LIMIT              3
+#define SSD1306_REPROBE_PERIOD          500
+#define SSD1306_PROBE_TRIALS            2
+#define SSD1306_PROBE_TIMEOUT           2       // ms
+
+// Power management, ms without ssd1306_power_activity(), 0 : disable
+#define SSD1306_DIM_TIMEOUT             30000
+#define SSD1306_OFF_TIMEOUT             120000
+#define SSD1306_DIM_CONTRAST            0x10
+
+// Burn-in protection, content orbits by SSD1306_SHIFT_MAX pixels every SSD1306_SHIFT_PERIOD ms, 0 : disable
+// Takes over the display offset register
+#define SSD1306_SHIFT_PERIOD            60000
+#define SSD1306_SHIFT_MAX               1
+
+// Lit pixel policy, applied by ssd1306_power_task() above SSD1306_LIT_THRESHOLD percent lit
+// DIM : lower contrast to SSD1306_LIT_CONTRAST, INVERSE : hardware inverse display
+#define SSD1306_LIT_POLICY              SSD1306_LIT_POLICY_DIM
+#define SSD1306_LIT_THRESHOLD           50      // %
+#define SSD1306_LIT_HYSTERESIS          10      // %
+#define SSD1306_LIT_CONTRAST            0x40
+
+// Panel current estimate, measure your module and adjust
+#define SSD1306_CURRENT_SLEEP_UA        10
+#define SSD1306_CURRENT_IDLE_UA         450     // display on, nothing lit
+#define SSD1306_CURRENT_FULL_UA         20000   // all pixels lit at contrast 0xFF
+
+
+#if defined(SSD1306_USE_RAMFUNC)
+#define SSD1306_RAM_FUNC        __attribute__((section(".ssd1306_ramfunc")))
+#else
+#define SSD1306_RAM_FUNC
+#endif
+
+#if defined(SSD1306_USE_BITBAND) && defined(__CORTEX_M) && (__CORTEX_M == 3 || __CORTEX_M == 4)
+#define SSD1306_BITBAND_SRAM    0x20000000
+#define SSD1306_BITBAND_ALIAS   0x22000000
+#define SSD1306_BITBAND_SIZE    0x00100000
+#endif
 
 
 /* SSD1306 Constant */
@@ -36,11 +153,49 @@
 #define SSD1306_HEIGHT          64
 #define SSD1306_PAGE            8
 
-#define SSD1306_BUFFER_SIZE     1024
+// Pages held in memory
+#if defined(SSD1306_USE_PAGE_STREAMING)
+#define SSD1306_BUFFER_PAGES    1
+#else
+#define SSD1306_BUFFER_PAGES    SSD1306_PAGE
+#endif
+#define SSD1306_BUFFER_SIZE     (SSD1306_WIDTH * SSD1306_BUFFER_PAGES)
+
+// Slot before the buffer keeps it word aligned
+#if defined(SSD1306_USE_ZERO_COPY)
+#define SSD1306_BUFFER_OFFSET   4
+#else
+#define SSD1306_BUFFER_OFFSET   0
+#endif
+#define SSD1306_FRAME_SIZE      (SSD1306_BUFFER_OFFSET + SSD1306_BUFFER_SIZE)
+
+#if SSD1306_DIRTY_TILE_WIDTH % 4 != 0 || SSD1306_WIDTH % SSD1306_DIRTY_TILE_WIDTH != 0
+#error "SSD1306_DIRTY_TILE_WIDTH must be a multiple of 4 that divides 128"
+#endif
+
+#define SSD1306_DIRTY_TILES     (SSD1306_WIDTH / SSD1306_DIRTY_TILE_WIDTH * SSD1306_PAGE)
+
+// Adjacent changed tiles merge, runs of a page are split by at least one unchanged tile
+#define SSD1306_DIRTY_RUNS      ((SSD1306_WIDTH / SSD1306_DIRTY_TILE_WIDTH + 1) / 2 * SSD1306_PAGE)
 
 #define SSD1306_BLACK           0
 #define SSD1306_WHITE           1
 
+// Raster op, source bit s (glyph or bitmap pixel, 1 for a drawn pixel) onto panel bit d
+#define SSD1306_ROP_SET         0       // d = s, opaque
+#define SSD1306_ROP_OR          1       // d = d | s, transparent
+#define SSD1306_ROP_CLEAR       2       // d = d & ~s
+#define SSD1306_ROP_XOR         3       // d = d ^ s
+#define SSD1306_ROP_INVERT      4       // d = ~s, opaque inverse video
+
+#define SSD1306_POWER_ACTIVE    0
+#define SSD1306_POWER_DIM       1
+#define SSD1306_POWER_OFF       2
+
+#define SSD1306_LIT_POLICY_NONE     0
+#define SSD1306_LIT_POLICY_DIM      1
+#define SSD1306_LIT_POLICY_INVERSE  2
+
 
 /* SSD1306 Struct */
 typedef struct
@@ -50,6 +205,68 @@ typedef struct
 
 } SSD1306_CURSOR;
 
+// Panel coordinates, right and bottom edge exclusive
+typedef struct
+{
+    uint8_t x0;
+    uint8_t y0;
+    uint8_t x1;
+    uint8_t y1;
+
+} SSD1306_CLIP;
+
+// Draws the whole screen, called by ssd1306_stream_frame() once per page
+typedef void (*SSD1306_DRAW_CALLBACK)(void* context);
+
+typedef struct
+{
+    uint8_t control;        // SSD1306_CONTROL_BYTE_COMMAND or SSD1306_CONTROL_BYTE_DATA
+    const uint8_t* buffer;
+    uint16_t size;
+
+} SSD1306_TRANSFER;
+
+typedef struct
+{
+    uint32_t init_start;    // timestamp of ssd1306_init() call
+    uint32_t boot_time;     // init start to first pixel data on the panel, 0 until then
+
+    uint32_t error_count;   // failed transfers
+    uint32_t nack_count;    // failed by address NACK
+    uint32_t recovery_count;// SCL clocking bus recoveries
+    uint32_t detach_count;  // switched to detached mode
+    uint32_t attach_count;  // re-probed and resynced
+
+    uint32_t frame_time;        // last flush, blocking or async, frame, region or dirty, start to last transfer done
+    uint32_t frame_sleep_time;  // of which spent in WFI, the rest is CPU busy, needs SSD1306_USE_SLEEP_STATS
+
+    uint32_t dirty_tiles;       // tiles sent by dirty flushes
+
+} SSD1306_STATS;
+
+// Controller registers set by the driver, raw command or parameter byte
+typedef struct
+{
+    uint8_t charge_pump;
+    uint8_t contrast;
+    uint8_t entire_display;     // 0xA4, 0xA5
+    uint8_t inverse;            // 0xA6, 0xA7
+    uint8_t display;            // 0xAE, 0xAF
+    uint8_t addressing_mode;
+    uint8_t start_line;         // 0x40 - 0x7F
+    uint8_t segment_remap;      // 0xA0, 0xA1
+    uint8_t multiplex_ratio;
+    uint8_t com_scan_direction; // 0xC0, 0xC8
+    uint8_t display_offset;
+    uint8_t com_pins;
+    uint8_t clock;
+    uint8_t pre_charge;
+    uint8_t vcomh;
+
+} SSD1306_STATE;
+
+#define SSD1306_STATE_SEQUENCE_SIZE     32
+
 
 /* Charge Bump Setting Command */
 #define CHARGE_BUMP_SETTING             0x8D   
@@ -95,11 +312,54 @@ typedef struct
 /* I2C Write Function */
 
 // @param : Select Command
-void ssd1306_write_command(uint8_t command);
+HAL_StatusTypeDef ssd1306_write_command(uint8_t command);
 
 // @param : Buffer Pointer
 // @param : Buffer Size
-void ssd1306_write_data(uint8_t* buffer, uint16_t size);
+HAL_StatusTypeDef ssd1306_write_data(uint8_t* buffer, uint16_t size);
+
+// Send several commands in one transaction
+// @param : Command Buffer Pointer
+// @param : Command Buffer Size
+HAL_StatusTypeDef ssd1306_write_commands(const uint8_t* buffer, uint16_t size);
+
+
+/* Transfer Queue Function */
+
+// Queue one transaction, starts right away when the bus is idle
+// Blocking build : runs to completion before return
+// @param : SSD1306_CONTROL_BYTE_COMMAND, SSD1306_CONTROL_BYTE_DATA
+// @param : Buffer Pointer, must stay valid until the transfer is done
+// @param : Buffer Size
+HAL_StatusTypeDef ssd1306_queue_transfer(uint8_t control, const uint8_t* buffer, uint16_t size);
+
+// 1 while a queued transfer is in progress
+uint8_t ssd1306_is_busy();
+
+// Wait until all queued transfers are done, sleeps with SSD1306_USE_SLEEP
+void ssd1306_wait_idle();
+
+// weak, called around the WFI wait, e.g. to lower the clock during long transfers
+void ssd1306_sleep_begin();
+void ssd1306_sleep_end();
+
+// Call from HAL_I2C_MemTxCpltCallback(), HAL_I2C_ErrorCallback()
+// and HAL_I2C_MasterTxCpltCallback() with SSD1306_USE_ZERO_COPY
+void ssd1306_i2c_tx_cplt_callback(I2C_HandleTypeDef *hi2c);
+void ssd1306_i2c_error_callback(I2C_HandleTypeDef *hi2c);
+
+
+/* Presence & Recovery Function */
+
+// Address the display with HAL_I2C_IsDeviceReady, a few ms when absent
+HAL_StatusTypeDef ssd1306_probe();
+
+// Clock SCL until the slave releases SDA, then STOP and re-init I2C
+// Runs automatically before the next transfer after a bus error
+void ssd1306_bus_recovery();
+
+// 0 : detached, writes return HAL_ERROR without touching the bus
+uint8_t ssd1306_is_attached();
 
 
 /* Charge Bump Setting Function */
@@ -110,29 +370,29 @@ void ssd1306_write_data(uint8_t* buffer, uint16_t size);
 // 0x14 : Enable Charge Pump
 // 0xAF : Display ON
 // @param : 0x10(disable, reset), 0x14(enable)
-void charge_bump_setting(uint8_t charge_bump); 
+HAL_StatusTypeDef charge_bump_setting(uint8_t charge_bump); 
 
 
 /* Fundamental Function */
 
 // @param : 0 - 255, 127(reset)
-void set_contrast_control(uint8_t value);
+HAL_StatusTypeDef set_contrast_control(uint8_t value);
 
 // Resume to RAM content display(reset)
-void entire_display_off();
-void entire_display_on();    
+HAL_StatusTypeDef entire_display_off();
+HAL_StatusTypeDef entire_display_on();    
 
 // 0x00 : BLACK, 0x01 : WHITE
-void set_normal_display();                
+HAL_StatusTypeDef set_normal_display();                
 
 // 0x00 : WHITE, 0x01 : BLACK
-void set_inverse_display();        
+HAL_StatusTypeDef set_inverse_display();        
 
 // sleep mode (reset)
-void set_display_off();   
+HAL_StatusTypeDef set_display_off();   
 
 // normal mode
-void set_display_on();                      
+HAL_StatusTypeDef set_display_on();                      
 
 
 /* Scrolling Function */
@@ -142,66 +402,125 @@ void set_display_on();
 /* Addressing Setting Function */
 
 // @param : 0x00(reset) - 0x0F
-void set_lower_column_start_address_for_page_addressing_mode(uint8_t addr);
+HAL_StatusTypeDef set_lower_column_start_address_for_page_addressing_mode(uint8_t addr);
 
 // @param : 0x10(reset) - 0x1F
-void set_higher_column_start_address_for_page_addressing_mode(uint8_t addr);
+HAL_StatusTypeDef set_higher_column_start_address_for_page_addressing_mode(uint8_t addr);
 
 // @param : 0(horizontal). 1(vertical), 2(page, reset)
-void set_memory_addressing_mode(uint8_t mode);
+HAL_StatusTypeDef set_memory_addressing_mode(uint8_t mode);
 
 // @param : 0(reset) - 127
 // @param : 0 - 127(reset)
-void set_column_address(uint8_t start, uint8_t end);
+HAL_StatusTypeDef set_column_address(uint8_t start, uint8_t end);
 
 // @param : 0(reset) - 7
 // @param : 0 - 7(reset)
-void set_page_address(uint8_t start, uint8_t end);
+HAL_StatusTypeDef set_page_address(uint8_t start, uint8_t end);
 
 // @param : 0xB0 - 0xB7
-void set_page_start_address_for_page_addressing_mode(uint8_t page);
+HAL_StatusTypeDef set_page_start_address_for_page_addressing_mode(uint8_t page);
 
 
 /* Hardware Configuration Function */
 
 // @param : 0x40(reset) - 0x7F
-void set_display_start_line(uint8_t start_line);
+HAL_StatusTypeDef set_display_start_line(uint8_t start_line);
 
 // @param : 0xA0(map, reset), 0xA1(remap)
-void set_segment_remap(uint8_t mapping);
+HAL_StatusTypeDef set_segment_remap(uint8_t mapping);
 
 // @param : 15 - 63(reset)
-void set_multiplex_ratio(uint8_t mux);
+HAL_StatusTypeDef set_multiplex_ratio(uint8_t mux);
 
 // @param : 0xC0(normal mode, reset), 0xC8(remapped mode)
-void set_com_output_scan_direction(uint8_t mode);
+HAL_StatusTypeDef set_com_output_scan_direction(uint8_t mode);
 
 // @param : 0(reset) - 63
-void set_display_offset(uint8_t vertical_shift);     
+HAL_StatusTypeDef set_display_offset(uint8_t vertical_shift);     
 
 // @param : 0(sequential), 1(alternative, reset)
 // @param : 0(disable, reset), 1(enable)
-void set_com_pins_hardware_config(uint8_t com_pin_config, uint8_t com_left_right_remap);
+HAL_StatusTypeDef set_com_pins_hardware_config(uint8_t com_pin_config, uint8_t com_left_right_remap);
 
 
 /* Timing & Driving Scheme Setting Function */
 
 // @param : 0(reset) - 15
 // @param : 0b0000 - 0b1111, 0b1000(reset)
-void set_display_clock_divide_ratio_and_osc_freq(uint8_t divide_ratio, uint8_t osc_freq);   
+HAL_StatusTypeDef set_display_clock_divide_ratio_and_osc_freq(uint8_t divide_ratio, uint8_t osc_freq);   
 
 // @param : 0x01 - 0x15, 0x02(reset)
 // @param : 0x01 - 0x15, 0x02(reset)
-void set_pre_charge_period(uint8_t phase_1, uint8_t phase_2);   
+HAL_StatusTypeDef set_pre_charge_period(uint8_t phase_1, uint8_t phase_2);   
 
 // @param : 0x00, 0x20(reset), 0x30
-void set_v_comh_deselect_level(uint8_t deselect_level);
+HAL_StatusTypeDef set_v_comh_deselect_level(uint8_t deselect_level);
+
+
+/* SSD1306 Pattern */
+extern const uint8_t ssd1306_pattern_solid[8];
+extern const uint8_t ssd1306_pattern_checker[8];  // 50 % checkerboard
+extern const uint8_t ssd1306_pattern_stipple[8];  // 12.5 % dots
+extern const uint8_t ssd1306_pattern_hatch[8];    // diagonal lines
 
 
 /* SSD1306 Function */
-void ssd1306_init();
 
-void ssd1306_update_screen();
+// Blocking init, clears display RAM
+// HAL_ERROR when the display does not answer, see ssd1306_heartbeat()
+// SSD1306_USE_EXTERNAL_BUFFER : call ssd1306_attach_frame() first
+HAL_StatusTypeDef ssd1306_init();
+
+// Queue init sequence, returns before the panel is ready with IT/DMA transfer
+// @param : 0(skip RAM clear, first frame follows), 1(clear RAM)
+HAL_StatusTypeDef ssd1306_init_async(uint8_t clear_ram);
+
+// Send whole buffer, horizontal addressing mode
+HAL_StatusTypeDef ssd1306_update_screen();
+
+// Queue whole buffer and return, don't draw until ssd1306_is_busy() is 0
+HAL_StatusTypeDef ssd1306_update_screen_async();
+
+// Send a column-major frame, 8 bytes per column top to bottom, in vertical addressing mode
+// Frame buffer is left alone, horizontal mode is restored afterwards
+// Burn-in shift and ssd1306_resync() re-send these columns until the next frame buffer flush
+// @param : SSD1306_WIDTH * SSD1306_PAGE bytes, must stay valid until sent, and while shown
+HAL_StatusTypeDef ssd1306_update_screen_vertical(const uint8_t* columns);
+HAL_StatusTypeDef ssd1306_update_screen_vertical_async(const uint8_t* columns);
+
+// Clear, draw and send a whole frame, cursor starts where it was on every call of draw
+// Streaming : draw runs once per page, pixels outside the current page are dropped
+// Draw code stays the same in both modes
+HAL_StatusTypeDef ssd1306_stream_frame(SSD1306_DRAW_CALLBACK draw, void* context);
+
+// Send one rectangle, rounded to whole pages
+// Full width : one data transaction, else one per page under a single column/page window
+// @param : x 0 - 127, y 0 - 63
+// @param : w 1 - 128, h 1 - 64
+HAL_StatusTypeDef ssd1306_update_region(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+HAL_StatusTypeDef ssd1306_update_region_async(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+
+// Send only tiles whose CRC changed since the last dirty flush, whole frame without SSD1306_USE_DIRTY_CRC
+// CRC unit on STM32, software CRC with the same result on host
+HAL_StatusTypeDef ssd1306_update_screen_dirty();
+HAL_StatusTypeDef ssd1306_update_screen_dirty_async();
+
+// CRC-32 of 32-bit words, poly 0x04C11DB7, init 0xFFFFFFFF (STM32 CRC unit)
+uint32_t ssd1306_crc32(const uint32_t* data, uint16_t words);
+
+// Registers set so far, used by ssd1306_resync()
+const SSD1306_STATE* ssd1306_get_state();
+
+// Restore panel after brownout or hot-plug
+// Replay cached registers in one transaction, then send whole buffer
+// Streaming : registers only, call ssd1306_stream_frame() to redraw
+HAL_StatusTypeDef ssd1306_resync();
+
+// Call periodically, re-sends critical registers every SSD1306_HEARTBEAT_PERIOD
+// Skipped while a transfer is in progress, never blocks
+// Detached : re-probes every SSD1306_REPROBE_PERIOD, resyncs when the display is back
+void ssd1306_heartbeat();
  
 void ssd1306_black_screen();
 void ssd1306_white_screen();
@@ -216,9 +535,62 @@ void ssd1306_black_pixel(uint8_t x, uint8_t y);
 // @param : 0 - 64
 void ssd1306_white_pixel(uint8_t x, uint8_t y);
 
+// Draw one pixel with the current raster op (SET, OR : white / CLEAR, INVERT : black / XOR : toggle)
+void ssd1306_draw_pixel(uint8_t x, uint8_t y);
+void ssd1306_draw_pixel_rop(uint8_t x, uint8_t y, uint8_t rop);
+
+// Glyph with the current raster op, SSD1306_ROP_SET draws the cell opaque
+// Glyphs across the panel or clip edge are cut, 0 : no part of the cell is visible, cursor stays
 char ssd1306_write_char(SSD1306_FONT font, char ch);
 char ssd1306_write_string(SSD1306_FONT font, char *str);
 
+// Same with the raster op of this call only
+char ssd1306_write_char_rop(SSD1306_FONT font, char ch, uint8_t rop);
+char ssd1306_write_string_rop(SSD1306_FONT font, char *str, uint8_t rop);
+
+// Page-major bitmap, ((h + 7) / 8) pages of w bytes, set bits are the source
+// Partly visible bitmaps are cut at the clip rectangle
+void ssd1306_draw_bitmap(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t* bitmap);
+void ssd1306_draw_bitmap_rop(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t* bitmap, uint8_t rop);
+
+// Horizontal and vertical lines with the current raster op, whole page bytes with masked ends
+// vline : at most one byte per page, hline : four columns per word in the middle
+void ssd1306_draw_hline(uint8_t x, uint8_t y, uint8_t w);
+void ssd1306_draw_vline(uint8_t x, uint8_t y, uint8_t h);
+void ssd1306_draw_hline_rop(uint8_t x, uint8_t y, uint8_t w, uint8_t rop);
+void ssd1306_draw_vline_rop(uint8_t x, uint8_t y, uint8_t h, uint8_t rop);
+
+// Rectangles with the current raster op, page bytes with masked top and bottom rows
+void ssd1306_fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+void ssd1306_draw_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+void ssd1306_draw_rect_rop(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t rop);
+
+// Pattern fill, 8 page bytes (one per column, bit 0 top row) repeated from panel 0, 0
+// Set bits are the source of the raster op, e.g. SSD1306_ROP_OR shades over a picture
+// @param : ssd1306_pattern_checker, ..., NULL : solid
+void ssd1306_fill_rect_rop(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t* pattern, uint8_t rop);
+
+// Raster op used by ssd1306_draw_pixel(), ssd1306_write_char() and ssd1306_write_string()
+// @param : SSD1306_ROP_SET(reset), _OR, _CLEAR, _XOR, _INVERT
+void ssd1306_set_rop(uint8_t rop);
+uint8_t ssd1306_get_rop();
+
+// Clip rectangle, cut to the one below it, local coordinates
+// Pixel, line, glyph and bitmap functions draw only inside, partly visible glyphs are cut
+// HAL_ERROR : SSD1306_CLIP_DEPTH levels in use
+HAL_StatusTypeDef ssd1306_push_clip(int16_t x, int16_t y, uint8_t w, uint8_t h);
+void ssd1306_pop_clip();
+
+// Same in panel coordinates, not cut to the clips below, e.g. display list tiles drawn under any application clip
+HAL_StatusTypeDef ssd1306_push_panel_clip(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+
+// Whole panel, origin 0, 0, also done by init
+void ssd1306_reset_clip();
+
+// Panel position of local 0, 0 for drawing and clip functions, e.g. scrolled list in a window
+void ssd1306_set_origin(int16_t x, int16_t y);
+void ssd1306_get_origin(int16_t* x, int16_t* y);
+
 // Set current cursor
 // @param : 0 - 128
 // @param : 0 - 64 
@@ -227,4 +599,86 @@ void ssd1306_set_cursor(uint8_t x, uint8_t y);
 void ssd1306_enter();
 void ssd1306_space();
 
+
+/* Power Management Function */
+
+// User activity, wakes the panel instantly without re-flush
+void ssd1306_power_activity();
+
+// Call periodically, dims after SSD1306_DIM_TIMEOUT, display off after SSD1306_OFF_TIMEOUT
+// and shifts content for burn-in protection every SSD1306_SHIFT_PERIOD
+void ssd1306_power_task();
+
+// SSD1306_POWER_ACTIVE, SSD1306_POWER_DIM, SSD1306_POWER_OFF
+uint8_t ssd1306_get_power_state();
+
+
+/* Buffer Operation Function */
+
+// Frame buffer, SSD1306_BUFFER_SIZE bytes, page-major
+uint8_t* ssd1306_get_buffer();
+
+// Row of one page, SSD1306_WIDTH bytes
+// Streaming : NULL unless the page is being drawn
+// @param : 0 - 7
+uint8_t* ssd1306_get_page(uint8_t page);
+
+// Draw and flush from caller-owned memory, e.g. DMA-safe section or shared image buffer
+// Swap at runtime to show pre-rendered screens, ssd1306_update_screen_dirty() sends only the difference
+// @param : SSD1306_FRAME_SIZE bytes, 4-byte aligned, NULL : internal frame
+// SSD1306_USE_BITBAND : HAL_ERROR outside the bit-band SRAM region
+HAL_StatusTypeDef ssd1306_attach_frame(uint8_t* frame);
+
+// Fill with a 32-bit pattern, byte at address a gets pattern byte a % 4
+// Frame buffer is word aligned : column x gets pattern byte x % 4
+// @param : Destination, any buffer
+// @param : Pattern, 0x00000000 clear, 0xFFFFFFFF set
+// @param : Size in bytes
+HAL_StatusTypeDef ssd1306_mem_fill(void* dst, uint32_t pattern, uint16_t size);
+
+// Copy screens or sprites between buffers
+HAL_StatusTypeDef ssd1306_mem_copy(void* dst, const void* src, uint16_t size);
+
+// Return while DMA runs, @param flush : 1(ssd1306_update_screen_async() when done)
+// The flush starts in thread context : next ssd1306_mem_is_busy(), ssd1306_mem_wait() or ssd1306_power_task()
+// Without SSD1306_USE_M2M_DMA runs on CPU before return
+HAL_StatusTypeDef ssd1306_mem_fill_async(void* dst, uint32_t pattern, uint16_t size, uint8_t flush);
+HAL_StatusTypeDef ssd1306_mem_copy_async(void* dst, const void* src, uint16_t size, uint8_t flush);
+
+uint8_t ssd1306_mem_is_busy();
+void ssd1306_mem_wait();
+
+// Call from SSD1306_M2M_DMA_STREAM IRQ handler
+void ssd1306_m2m_dma_irq_handler();
+
+
+/* Lit Pixel Function */
+
+// Set bits in a word
+uint32_t ssd1306_popcount32(uint32_t word);
+
+// Recount the whole buffer, drawing keeps the count up to date without this
+uint16_t ssd1306_count_lit_pixels();
+
+// 0 - 8192
+uint16_t ssd1306_get_lit_pixels();
+
+// Bytes written without the drawing or mem functions, e.g. ssd1306_kernel.c
+// Overlaps the frame buffer : recounted on next ssd1306_get_lit_pixels()
+void ssd1306_mem_touch(const void* dst, uint16_t size);
+
+// Estimated panel current in uA from lit pixels, contrast and display on/off
+// Pixels the panel lights : inverse display and entire display on are taken into account
+uint32_t ssd1306_get_panel_current();
+
+
+/* Statistics Function */
+
+// Timestamp source, DWT cycle counter if available else HAL_GetTick()
+// weak, override for host stub
+// CYCCNT stops in WFI : frame_time without SSD1306_USE_SLEEP_STATS counts CPU busy cycles only
+uint32_t ssd1306_get_timestamp();
+
+const SSD1306_STATS* ssd1306_get_stats();
+
 #endif /* __SSD1306_H__ */
\ No newline at end of file
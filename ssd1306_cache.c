@@ -0,0 +1,237 @@
+/*
+ * ssd1306_cache.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#include "ssd1306_cache.h"
+#include <string.h> // memcpy, memmove, memset
+#include <stdint.h> // uintptr_t
+
+
+/* SSD1306 Screen Cache Variable */
+
+typedef struct
+{
+    uint8_t stored;
+    uint16_t offset;                    // into cache_arena
+    uint8_t page_size[SSD1306_PAGE];    // coded bytes, 0 : all-zero page, SSD1306_WIDTH : raw page
+
+} SSD1306_CACHE_SLOT;
+
+static SSD1306_CACHE_SLOT cache_slot[SSD1306_CACHE_SLOTS];
+static uint8_t cache_arena[SSD1306_CACHE_SIZE];
+static uint16_t cache_used;
+
+
+/* Run-Length Coding */
+// Control byte c : 0x00 - 0x7F, c + 1 literal bytes follow
+//                  0x81 - 0xFF, next byte repeated c - 0x80 + 2 times
+// Pairs stay in the literal run, only runs of 3 or more break it
+// @return : SSD1306_WIDTH when coding does not save space, dst then holds an incomplete code, store raw
+static uint8_t ssd1306_cache_pack(const uint8_t* src, uint8_t* dst)
+{
+    uint16_t i = 0, n = 0;
+
+    while(i < SSD1306_WIDTH && src[i] == 0x00)
+        i++;
+
+    if(i == SSD1306_WIDTH)
+        return 0;
+
+    i = 0;
+
+    while(i < SSD1306_WIDTH)
+    {
+        uint16_t run = 1;
+
+        while(i + run < SSD1306_WIDTH && src[i + run] == src[i] && run < 129)
+            run++;
+
+        if(run >= 3)
+        {
+            if(n + 2 >= SSD1306_WIDTH)
+                return SSD1306_WIDTH;
+
+            dst[n++] = 0x80 + run - 2;
+            dst[n++] = src[i];
+            i += run;
+        }
+        else
+        {
+            // Literals up to the next run of 3
+            uint16_t start = i;
+
+            while(i < SSD1306_WIDTH && i - start < 128 &&
+                  !(i + 2 < SSD1306_WIDTH && src[i] == src[i + 1] && src[i] == src[i + 2]))
+                i++;
+
+            if(n + 1 + i - start >= SSD1306_WIDTH)
+                return SSD1306_WIDTH;
+
+            dst[n++] = i - start - 1;
+            memcpy(&dst[n], &src[start], i - start);
+            n += i - start;
+        }
+    }
+
+    return n;
+}
+
+static void ssd1306_cache_unpack(const uint8_t* src, uint8_t size, uint8_t* dst)
+{
+    const uint8_t* end = src + size;
+
+    if(size == 0)
+    {
+        memset(dst, 0x00, SSD1306_WIDTH);
+        return;
+    }
+
+    if(size == SSD1306_WIDTH)
+    {
+        memcpy(dst, src, SSD1306_WIDTH);
+        return;
+    }
+
+    while(src < end)
+    {
+        uint8_t c = *src++;
+
+        if(c < 0x80)
+        {
+            memcpy(dst, src, c + 1);
+            dst += c + 1;
+            src += c + 1;
+        }
+        else
+        {
+            memset(dst, *src++, c - 0x80 + 2);
+            dst += c - 0x80 + 2;
+        }
+    }
+}
+
+
+/* Screen Cache Function */
+void ssd1306_cache_free(uint8_t slot)
+{
+    SSD1306_CACHE_SLOT* entry = &cache_slot[slot];
+    uint16_t size = 0;
+
+    if(slot >= SSD1306_CACHE_SLOTS || !entry->stored)
+        return;
+
+    for(uint8_t page = 0; page < SSD1306_PAGE; page++)
+        size += entry->page_size[page];
+
+    // Close the gap, arena stays one free block at the end
+    memmove(&cache_arena[entry->offset], &cache_arena[entry->offset + size], cache_used - entry->offset - size);
+    cache_used -= size;
+
+    for(uint8_t i = 0; i < SSD1306_CACHE_SLOTS; i++)
+    {
+        if(cache_slot[i].stored && cache_slot[i].offset > entry->offset)
+            cache_slot[i].offset -= size;
+    }
+
+    entry->stored = 0;
+}
+
+HAL_StatusTypeDef ssd1306_cache_store(uint8_t slot)
+{
+    SSD1306_CACHE_SLOT* entry = &cache_slot[slot];
+    uint8_t packed[SSD1306_WIDTH];
+    uint16_t offset;
+
+    if(slot >= SSD1306_CACHE_SLOTS)
+        return HAL_ERROR;
+
+    ssd1306_cache_free(slot);
+
+    offset = cache_used;
+    entry->offset = offset;
+
+    for(uint8_t page = 0; page < SSD1306_PAGE; page++)
+    {
+        const uint8_t* src = ssd1306_get_page(page);
+        uint8_t size;
+
+        // Streaming holds one page only
+        if(src == NULL)
+        {
+            cache_used = entry->offset;
+            return HAL_ERROR;
+        }
+
+        size = ssd1306_cache_pack(src, packed);
+
+        if(size > SSD1306_CACHE_SIZE - offset)
+        {
+            cache_used = entry->offset;
+            return HAL_ERROR;
+        }
+
+        memcpy(&cache_arena[offset], size == SSD1306_WIDTH ? src : packed, size);
+        entry->page_size[page] = size;
+        offset += size;
+    }
+
+    cache_used = offset;
+    entry->stored = 1;
+
+    return HAL_OK;
+}
+
+void ssd1306_cache_draw(void* context)
+{
+    SSD1306_CACHE_SLOT* entry = &cache_slot[(uintptr_t)context];
+    uint8_t row[SSD1306_WIDTH] __attribute__((aligned(4)));
+    uint16_t offset;
+
+    if((uintptr_t)context >= SSD1306_CACHE_SLOTS || !entry->stored)
+        return;
+
+    offset = entry->offset;
+
+    for(uint8_t page = 0; page < SSD1306_PAGE; page++)
+    {
+        uint8_t* dst = ssd1306_get_page(page);
+
+        if(dst != NULL)
+        {
+            ssd1306_cache_unpack(&cache_arena[offset], entry->page_size[page], row);
+
+            // Lit pixel count follows the copy
+            ssd1306_mem_copy(dst, row, SSD1306_WIDTH);
+        }
+
+        offset += entry->page_size[page];
+    }
+}
+
+HAL_StatusTypeDef ssd1306_cache_show(uint8_t slot)
+{
+    if(!ssd1306_cache_is_stored(slot))
+        return HAL_ERROR;
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    return ssd1306_stream_frame(ssd1306_cache_draw, (void*)(uintptr_t)slot);
+#else
+    ssd1306_cache_draw((void*)(uintptr_t)slot);
+
+    return ssd1306_update_screen_dirty();
+#endif
+}
+
+uint8_t ssd1306_cache_is_stored(uint8_t slot)
+{
+    return slot < SSD1306_CACHE_SLOTS && cache_slot[slot].stored;
+}
+
+uint16_t ssd1306_cache_get_used()
+{
+    return cache_used;
+}
@@ -0,0 +1,49 @@
+/*
+ * ssd1306_cache.h
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#ifndef __SSD1306_CACHE_H__
+#define __SSD1306_CACHE_H__
+
+
+#include "ssd1306.h"
+
+
+/* SSD1306 Screen Cache Option */
+
+// Screens kept off-screen
+#define SSD1306_CACHE_SLOTS         4
+
+// Bytes shared by all slots, static arena, no heap
+#define SSD1306_CACHE_SIZE          1024
+
+
+/* SSD1306 Screen Cache Function */
+
+// Compress the frame buffer into a slot, replaces what the slot held
+// Per page : all-zero page takes no space, else run-length coded (PackBits), raw when coding does not save space
+// HAL_ERROR : does not fit the free arena, slot is left empty
+// Streaming : HAL_ERROR, the frame is never in memory
+HAL_StatusTypeDef ssd1306_cache_store(uint8_t slot);
+
+// Decompress a slot into the frame buffer, pages not held in memory are skipped
+// Usable as ssd1306_stream_frame() callback, context : slot number cast to pointer
+void ssd1306_cache_draw(void* context);
+
+// Decompress and send, ssd1306_update_screen_dirty() sends only the tiles that differ
+// Streaming : decompressed a page at a time straight into the flush
+HAL_StatusTypeDef ssd1306_cache_show(uint8_t slot);
+
+void ssd1306_cache_free(uint8_t slot);
+
+uint8_t ssd1306_cache_is_stored(uint8_t slot);
+
+// Arena bytes in use
+uint16_t ssd1306_cache_get_used();
+
+
+#endif /* __SSD1306_CACHE_H__ */
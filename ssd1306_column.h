@@ -0,0 +1,53 @@
+/*
+ * ssd1306_column.h
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#ifndef __SSD1306_COLUMN_H__
+#define __SSD1306_COLUMN_H__
+
+
+#include "ssd1306.h"
+
+
+/* SSD1306 Column-Major Canvas Function */
+
+// One uint64_t per column, bit y is row y
+// Little-endian memory is the vertical addressing mode byte stream, sent as is
+uint64_t* ssd1306_column_get_buffer();
+
+void ssd1306_column_clear();
+
+// @param : 0 - 127
+// @param : 0 - 63
+void ssd1306_column_black_pixel(uint8_t x, uint8_t y);
+void ssd1306_column_white_pixel(uint8_t x, uint8_t y);
+
+// Rows y0 - y1 of one column in a single mask operation
+// @param : SSD1306_BLACK, SSD1306_WHITE
+void ssd1306_column_vline(uint8_t x, uint8_t y0, uint8_t y1, uint8_t color);
+
+// Bar graph, columns x - x + w - 1 lit from the bottom row up h rows, rows above cleared
+// One store per column, no clear needed between chart frames
+// @param : h 0 - 64
+void ssd1306_column_bar(uint8_t x, uint8_t w, uint8_t h);
+
+// Glyph cell drawn opaque at x, y, each glyph column assembled and stored once
+// Columns past the right edge and rows below the bottom are cut
+// @return : ch, 0 when not printable or x, y off the canvas
+char ssd1306_column_write_char(uint8_t x, uint8_t y, SSD1306_FONT font, char ch);
+char ssd1306_column_write_string(uint8_t x, uint8_t y, SSD1306_FONT font, char* str);
+
+// Horizontal scroll by whole columns, blank columns come in, e.g. strip chart one column per sample
+// @param : dx < 0 : left, dx > 0 : right
+void ssd1306_column_scroll(int8_t dx);
+
+// ssd1306_update_screen_vertical() on the canvas
+HAL_StatusTypeDef ssd1306_column_update_screen();
+HAL_StatusTypeDef ssd1306_column_update_screen_async();
+
+
+#endif /* __SSD1306_COLUMN_H__ */
@@ -0,0 +1,534 @@
+/*
+ * ssd1306_list.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#include "ssd1306_list.h"
+#include <string.h> // memcmp, strncpy
+
+
+/* SSD1306 Display List Variable */
+
+static SSD1306_LIST_ENTRY list[SSD1306_LIST_SIZE];
+static uint32_t list_invalid[SSD1306_PAGE];    // bit t : tile t of the page needs redraw
+
+// Rasterization window, exclusive right and bottom edge, also pushed as the driver clip
+static uint8_t clip_x0, clip_y0, clip_x1, clip_y1;
+
+// Raster op of a source bit that leaves the buffer unchanged
+#define SSD1306_LIST_ROP_NONE   0xFF
+
+
+/* Bounding Box */
+// @return : 0 when the entry draws nothing
+static uint8_t ssd1306_list_bounds(const SSD1306_LIST_ENTRY* entry, int16_t* x0, int16_t* y0, int16_t* x1, int16_t* y1)
+{
+    if(entry->type == SSD1306_LIST_NONE)
+        return 0;
+
+    if(entry->type == SSD1306_LIST_TEXT && entry->text.data[0] == '\0')
+        return 0;
+
+    // Line runs either way, box is the corners sorted
+    *x0 = entry->x0 < entry->x1 ? entry->x0 : entry->x1;
+    *x1 = entry->x0 < entry->x1 ? entry->x1 : entry->x0;
+    *y0 = entry->y0 < entry->y1 ? entry->y0 : entry->y1;
+    *y1 = entry->y0 < entry->y1 ? entry->y1 : entry->y0;
+
+    return 1;
+}
+
+// Bottom right corner of a text entry
+static void ssd1306_list_text_bounds(SSD1306_LIST_ENTRY* entry)
+{
+    entry->x1 = entry->x0 + strlen(entry->text.data) * entry->text.font.width - 1;
+    entry->y1 = entry->y0 + entry->text.font.height - 1;
+}
+
+static void ssd1306_list_invalidate(const SSD1306_LIST_ENTRY* entry)
+{
+    int16_t x0, y0, x1, y1;
+    uint32_t mask;
+
+    if(!ssd1306_list_bounds(entry, &x0, &y0, &x1, &y1) || x0 >= SSD1306_WIDTH || y0 >= SSD1306_HEIGHT || x1 < 0 || y1 < 0)
+        return;
+
+    // Lines can end left of or above the panel
+    if(x0 < 0)
+        x0 = 0;
+
+    if(y0 < 0)
+        y0 = 0;
+
+    if(x1 >= SSD1306_WIDTH)
+        x1 = SSD1306_WIDTH - 1;
+
+    if(y1 >= SSD1306_HEIGHT)
+        y1 = SSD1306_HEIGHT - 1;
+
+    // Tiles x0 / TW to x1 / TW of every page the box touches
+    mask = (uint32_t)((2ULL << (x1 / SSD1306_DIRTY_TILE_WIDTH)) - 1) & ~((1UL << (x0 / SSD1306_DIRTY_TILE_WIDTH)) - 1);
+
+    for(uint8_t page = y0 / 8; page <= y1 / 8; page++)
+        list_invalid[page] |= mask;
+}
+
+
+/* Rasterization */
+// Source bit of the entry, black entries invert it, opaque raster ops also draw the 0 bits
+static uint8_t ssd1306_list_rop(const SSD1306_LIST_ENTRY* entry, uint8_t source)
+{
+    if(entry->color == SSD1306_BLACK)
+        source = !source;
+
+    if(source)
+        return entry->rop;
+    else if(entry->rop == SSD1306_ROP_SET)
+        return SSD1306_ROP_CLEAR;
+    else if(entry->rop == SSD1306_ROP_INVERT)
+        return SSD1306_ROP_SET;
+
+    return SSD1306_LIST_ROP_NONE;
+}
+
+// Every write goes through the clip, entries outside the tile keep their pixels
+static void ssd1306_list_pixel(const SSD1306_LIST_ENTRY* entry, int16_t x, int16_t y, uint8_t source)
+{
+    uint8_t rop;
+
+    if(x < clip_x0 || x >= clip_x1 || y < clip_y0 || y >= clip_y1)
+        return;
+
+    rop = ssd1306_list_rop(entry, source);
+
+    if(rop != SSD1306_LIST_ROP_NONE)
+        ssd1306_draw_pixel_rop(x, y, rop);
+}
+
+// Box x0 - x1, y0 - y1 inclusive as one ssd1306_fill_rect_rop(), cut to the window first so it fits the 0 - 255 coordinates
+static void ssd1306_list_box(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t rop)
+{
+    if(x0 < clip_x0)
+        x0 = clip_x0;
+
+    if(y0 < clip_y0)
+        y0 = clip_y0;
+
+    if(x1 >= clip_x1)
+        x1 = clip_x1 - 1;
+
+    if(y1 >= clip_y1)
+        y1 = clip_y1 - 1;
+
+    if(x0 > x1 || y0 > y1)
+        return;
+
+    ssd1306_fill_rect_rop(x0, y0, x1 - x0 + 1, y1 - y0 + 1, NULL, rop);
+}
+
+// Opaque glyph cells like ssd1306_write_char(), cells outside the clip are skipped
+static void ssd1306_list_draw_text(const SSD1306_LIST_ENTRY* entry)
+{
+    const SSD1306_FONT* font = &entry->text.font;
+    uint16_t x = entry->x0;
+
+    for(const char* ch = entry->text.data; *ch && x < clip_x1; ch++, x += font->width)
+    {
+        if(*ch < 32 || *ch > 126 || x + font->width <= clip_x0)
+            continue;
+
+        for(int i = 0; i < font->height; i++)
+        {
+            uint32_t b = font->data[(*ch - 32) * font->height + i];
+            uint16_t y = entry->y0 + i;
+
+            if(y < clip_y0 || y >= clip_y1)
+                continue;
+
+            for(int j = 0; j < font->width; j++)
+            {
+                uint8_t lit = ((b << j) & 0x8000) != 0;
+
+                ssd1306_list_pixel(entry, x + j, y, lit);
+            }
+        }
+    }
+}
+
+// Bresenham, whole line is walked, shallow lines go out as row runs, steep lines as column runs
+static void ssd1306_list_draw_line(const SSD1306_LIST_ENTRY* entry)
+{
+    uint8_t rop = ssd1306_list_rop(entry, 1);
+    int x = entry->x0, y = entry->y0;
+    int dx = entry->x1 > x ? entry->x1 - x : x - entry->x1;
+    int dy = entry->y1 > y ? y - entry->y1 : entry->y1 - y;
+    int sx = entry->x1 > x ? 1 : -1;
+    int sy = entry->y1 > y ? 1 : -1;
+    int err = dx + dy;
+    uint8_t steep = -dy > dx;
+    int run_x = x, run_y = y;
+
+    if(rop == SSD1306_LIST_ROP_NONE)
+        return;
+
+    for(;;)
+    {
+        int last_x = x, last_y = y;
+
+        if(x == entry->x1 && y == entry->y1)
+        {
+            ssd1306_list_box(run_x < x ? run_x : x, run_y < y ? run_y : y, run_x < x ? x : run_x, run_y < y ? y : run_y, rop);
+            break;
+        }
+
+        if(2 * err >= dy)
+        {
+            err += dy;
+            x += sx;
+        }
+
+        if(2 * err <= dx)
+        {
+            err += dx;
+            y += sy;
+        }
+
+        // Run ends where the minor coordinate steps
+        if(steep ? x != last_x : y != last_y)
+        {
+            ssd1306_list_box(run_x < last_x ? run_x : last_x, run_y < last_y ? run_y : last_y,
+                             run_x < last_x ? last_x : run_x, run_y < last_y ? last_y : run_y, rop);
+            run_x = x;
+            run_y = y;
+        }
+    }
+}
+
+// Filled box as one span, outline as top and bottom rows and the side columns between them, every pixel once
+static void ssd1306_list_draw_rect(const SSD1306_LIST_ENTRY* entry)
+{
+    uint8_t rop = ssd1306_list_rop(entry, 1);
+
+    if(rop == SSD1306_LIST_ROP_NONE)
+        return;
+
+    if(entry->fill || entry->y1 - entry->y0 < 2 || entry->x1 - entry->x0 < 2)
+    {
+        ssd1306_list_box(entry->x0, entry->y0, entry->x1, entry->y1, rop);
+        return;
+    }
+
+    ssd1306_list_box(entry->x0, entry->y0, entry->x1, entry->y0, rop);
+    ssd1306_list_box(entry->x0, entry->y1, entry->x1, entry->y1, rop);
+    ssd1306_list_box(entry->x0, entry->y0 + 1, entry->x0, entry->y1 - 1, rop);
+    ssd1306_list_box(entry->x1, entry->y0 + 1, entry->x1, entry->y1 - 1, rop);
+}
+
+static void ssd1306_list_draw_bitmap(const SSD1306_LIST_ENTRY* entry)
+{
+    uint8_t w = entry->x1 - entry->x0 + 1;
+    int16_t x0 = entry->x0 > clip_x0 ? entry->x0 : clip_x0;
+    int16_t y0 = entry->y0 > clip_y0 ? entry->y0 : clip_y0;
+    int16_t x1 = entry->x1 < clip_x1 - 1 ? entry->x1 : clip_x1 - 1;
+    int16_t y1 = entry->y1 < clip_y1 - 1 ? entry->y1 : clip_y1 - 1;
+
+    for(int16_t y = y0; y <= y1; y++)
+    {
+        uint8_t row = y - entry->y0;
+
+        for(int16_t x = x0; x <= x1; x++)
+        {
+            uint8_t bit = (entry->bitmap[(row / 8) * w + (x - entry->x0)] >> (row % 8)) & 1;
+
+            ssd1306_list_pixel(entry, x, y, bit);
+        }
+    }
+}
+
+// Entries in list order, later ones on top
+// Entries are in panel coordinates, the application's origin and clip are set aside while they are drawn
+static void ssd1306_list_raster(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+    int16_t origin_x, origin_y;
+
+    if(ssd1306_push_panel_clip(x0, y0, x1 - x0, y1 - y0) != HAL_OK)
+        return;
+
+    ssd1306_get_origin(&origin_x, &origin_y);
+    ssd1306_set_origin(0, 0);
+
+    clip_x0 = x0;
+    clip_y0 = y0;
+    clip_x1 = x1;
+    clip_y1 = y1;
+
+    for(int i = 0; i < SSD1306_LIST_SIZE; i++)
+    {
+        const SSD1306_LIST_ENTRY* entry = &list[i];
+        int16_t bx0, by0, bx1, by1;
+
+        if(!ssd1306_list_bounds(entry, &bx0, &by0, &bx1, &by1))
+            continue;
+
+        if(bx0 >= x1 || by0 >= y1 || bx1 < x0 || by1 < y0)
+            continue;
+
+        switch(entry->type)
+        {
+            case SSD1306_LIST_TEXT:     ssd1306_list_draw_text(entry);      break;
+            case SSD1306_LIST_LINE:     ssd1306_list_draw_line(entry);      break;
+            case SSD1306_LIST_RECT:     ssd1306_list_draw_rect(entry);      break;
+            case SSD1306_LIST_BITMAP:   ssd1306_list_draw_bitmap(entry);    break;
+        }
+    }
+
+    ssd1306_set_origin(origin_x, origin_y);
+    ssd1306_pop_clip();
+}
+
+
+/* Display List Function */
+static int8_t ssd1306_list_add(uint8_t type, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color)
+{
+    for(int8_t i = 0; i < SSD1306_LIST_SIZE; i++)
+    {
+        SSD1306_LIST_ENTRY* entry = &list[i];
+
+        if(entry->type != SSD1306_LIST_NONE)
+            continue;
+
+        entry->type = type;
+        entry->color = color;
+        entry->rop = SSD1306_ROP_SET;
+        entry->fill = 0;
+        entry->x0 = x0;
+        entry->y0 = y0;
+        entry->x1 = x1;
+        entry->y1 = y1;
+
+        return i;
+    }
+
+    return -1;
+}
+
+static SSD1306_LIST_ENTRY* ssd1306_list_entry(int8_t handle)
+{
+    if(handle < 0 || handle >= SSD1306_LIST_SIZE || list[handle].type == SSD1306_LIST_NONE)
+        return NULL;
+
+    return &list[handle];
+}
+
+int8_t ssd1306_list_add_text(uint8_t x, uint8_t y, SSD1306_FONT font, const char* text, uint8_t color)
+{
+    int8_t handle = ssd1306_list_add(SSD1306_LIST_TEXT, x, y, x, y, color);
+    SSD1306_LIST_ENTRY* entry = ssd1306_list_entry(handle);
+
+    if(entry == NULL)
+        return -1;
+
+    entry->text.font = font;
+    entry->text.data[0] = '\0';
+
+    ssd1306_list_set_text(handle, text);
+
+    return handle;
+}
+
+int8_t ssd1306_list_add_line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color)
+{
+    int8_t handle = ssd1306_list_add(SSD1306_LIST_LINE, x0, y0, x1, y1, color);
+
+    if(handle >= 0)
+        ssd1306_list_invalidate(&list[handle]);
+
+    return handle;
+}
+
+int8_t ssd1306_list_add_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color, uint8_t fill)
+{
+    int8_t handle;
+
+    if(w == 0 || h == 0)
+        return -1;
+
+    handle = ssd1306_list_add(SSD1306_LIST_RECT, x, y, x + w - 1, y + h - 1, color);
+
+    if(handle >= 0)
+    {
+        list[handle].fill = fill;
+        ssd1306_list_invalidate(&list[handle]);
+    }
+
+    return handle;
+}
+
+int8_t ssd1306_list_add_bitmap(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t* bitmap)
+{
+    int8_t handle;
+
+    if(w == 0 || h == 0 || bitmap == NULL)
+        return -1;
+
+    handle = ssd1306_list_add(SSD1306_LIST_BITMAP, x, y, x + w - 1, y + h - 1, SSD1306_WHITE);
+
+    if(handle >= 0)
+    {
+        list[handle].bitmap = bitmap;
+        ssd1306_list_invalidate(&list[handle]);
+    }
+
+    return handle;
+}
+
+void ssd1306_list_set_text(int8_t handle, const char* text)
+{
+    SSD1306_LIST_ENTRY* entry = ssd1306_list_entry(handle);
+
+    if(entry == NULL || entry->type != SSD1306_LIST_TEXT)
+        return;
+
+    if(strncmp(entry->text.data, text, SSD1306_LIST_TEXT_SIZE) == 0)
+        return;
+
+    ssd1306_list_invalidate(entry);
+
+    strncpy(entry->text.data, text, SSD1306_LIST_TEXT_SIZE);
+    entry->text.data[SSD1306_LIST_TEXT_SIZE] = '\0';
+    ssd1306_list_text_bounds(entry);
+
+    ssd1306_list_invalidate(entry);
+}
+
+void ssd1306_list_set_color(int8_t handle, uint8_t color)
+{
+    SSD1306_LIST_ENTRY* entry = ssd1306_list_entry(handle);
+
+    if(entry == NULL || entry->color == color)
+        return;
+
+    entry->color = color;
+
+    ssd1306_list_invalidate(entry);
+}
+
+void ssd1306_list_set_rop(int8_t handle, uint8_t rop)
+{
+    SSD1306_LIST_ENTRY* entry = ssd1306_list_entry(handle);
+
+    if(entry == NULL || entry->rop == rop)
+        return;
+
+    entry->rop = rop;
+
+    ssd1306_list_invalidate(entry);
+}
+
+void ssd1306_list_move(int8_t handle, uint8_t x, uint8_t y)
+{
+    SSD1306_LIST_ENTRY* entry = ssd1306_list_entry(handle);
+
+    if(entry == NULL || (entry->x0 == x && entry->y0 == y))
+        return;
+
+    ssd1306_list_invalidate(entry);
+
+    // Keep the signed offset to the second corner, line keeps its direction even off the panel
+    entry->x1 += x - entry->x0;
+    entry->y1 += y - entry->y0;
+    entry->x0 = x;
+    entry->y0 = y;
+
+    if(entry->type == SSD1306_LIST_TEXT)
+        ssd1306_list_text_bounds(entry);
+
+    ssd1306_list_invalidate(entry);
+}
+
+void ssd1306_list_remove(int8_t handle)
+{
+    SSD1306_LIST_ENTRY* entry = ssd1306_list_entry(handle);
+
+    if(entry == NULL)
+        return;
+
+    ssd1306_list_invalidate(entry);
+
+    entry->type = SSD1306_LIST_NONE;
+}
+
+void ssd1306_list_clear()
+{
+    for(int8_t i = 0; i < SSD1306_LIST_SIZE; i++)
+        ssd1306_list_remove(i);
+}
+
+const SSD1306_LIST_ENTRY* ssd1306_list_get(int8_t handle)
+{
+    return ssd1306_list_entry(handle);
+}
+
+void ssd1306_list_draw(void* context)
+{
+    (void)context;
+
+    ssd1306_list_raster(0, 0, SSD1306_WIDTH, SSD1306_HEIGHT);
+}
+
+HAL_StatusTypeDef ssd1306_list_render()
+{
+    HAL_StatusTypeDef status = HAL_OK;
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    // No frame to patch, every page is drawn again
+    memset(list_invalid, 0, sizeof(list_invalid));
+
+    status = ssd1306_stream_frame(ssd1306_list_draw, NULL);
+#else
+    for(uint8_t page = 0; page < SSD1306_PAGE && status == HAL_OK; page++)
+    {
+        uint32_t mask = list_invalid[page];
+        uint8_t start = 0xFF;
+
+        if(mask == 0)
+            continue;
+
+        // Clear and redraw each invalid tile, clipped so neighbours keep their pixels
+        for(uint8_t t = 0; t < SSD1306_LIST_TILES; t++)
+        {
+            uint8_t x = t * SSD1306_DIRTY_TILE_WIDTH;
+
+            if(!(mask & (1UL << t)))
+                continue;
+
+            ssd1306_mem_fill(ssd1306_get_page(page) + x, 0x00000000, SSD1306_DIRTY_TILE_WIDTH);
+            ssd1306_list_raster(x, page * 8, x + SSD1306_DIRTY_TILE_WIDTH, page * 8 + 8);
+        }
+
+        // Adjacent tiles go out in one region, one step past the last tile closes an open run
+        for(uint8_t t = 0; t <= SSD1306_LIST_TILES && status == HAL_OK; t++)
+        {
+            uint8_t invalid = t < SSD1306_LIST_TILES && (mask & (1UL << t));
+
+            if(invalid && start == 0xFF)
+            {
+                start = t;
+            }
+            else if(!invalid && start != 0xFF)
+            {
+                status = ssd1306_update_region(start * SSD1306_DIRTY_TILE_WIDTH, page * 8, (t - start) * SSD1306_DIRTY_TILE_WIDTH, 8);
+                start = 0xFF;
+            }
+        }
+
+        if(status == HAL_OK)
+            list_invalid[page] = 0;
+    }
+#endif
+
+    return status;
+}
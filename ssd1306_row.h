@@ -0,0 +1,55 @@
+/*
+ * ssd1306_row.h
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#ifndef __SSD1306_ROW_H__
+#define __SSD1306_ROW_H__
+
+
+#include "ssd1306.h"
+
+
+/* SSD1306 Row-Major Canvas Constant */
+
+// Bytes per row, MSB is the leftmost pixel like font rows
+#define SSD1306_ROW_STRIDE          (SSD1306_WIDTH / 8)
+
+
+/* SSD1306 Row-Major Canvas Function */
+
+// Canvas, SSD1306_HEIGHT rows of SSD1306_ROW_STRIDE bytes
+// Writing through the pointer : call ssd1306_row_invalidate()
+uint8_t* ssd1306_row_get_buffer();
+
+void ssd1306_row_clear();
+
+// @param : 0 - 127
+// @param : 0 - 63
+void ssd1306_row_black_pixel(uint8_t x, uint8_t y);
+void ssd1306_row_white_pixel(uint8_t x, uint8_t y);
+
+// Columns x0 - x1 of one row, whole bytes in the middle
+// @param : SSD1306_BLACK, SSD1306_WHITE
+void ssd1306_row_hline(uint8_t x0, uint8_t x1, uint8_t y, uint8_t color);
+
+// Convert every 8x8 block on next flush
+void ssd1306_row_invalidate();
+
+// 8x8 bit transpose : 8 row bytes, stride apart, to 8 page bytes (column bytes, top row in D0)
+// Two 32-bit words, RBIT on Cortex-M, shift-and-mask fallback elsewhere
+void ssd1306_row_transpose8(const uint8_t* src, uint8_t stride, uint8_t* dst);
+
+// Convert every block into the frame buffer, pages not held in memory are skipped
+// Usable as ssd1306_stream_frame() callback
+void ssd1306_row_draw(void* context);
+
+// Convert only blocks written since the last flush, send with ssd1306_update_screen_dirty()
+// Streaming : ssd1306_stream_frame(ssd1306_row_draw, NULL)
+HAL_StatusTypeDef ssd1306_row_update_screen();
+
+
+#endif /* __SSD1306_ROW_H__ */
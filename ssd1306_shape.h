@@ -0,0 +1,49 @@
+/*
+ * ssd1306_shape.h
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#ifndef __SSD1306_SHAPE_H__
+#define __SSD1306_SHAPE_H__
+
+
+#include "ssd1306.h"
+
+
+/* SSD1306 Shape Constant */
+
+// Larger radii are cut, keeps the integer ellipse test in 32 bits
+#define SSD1306_SHAPE_RADIUS_MAX    127
+
+
+/* SSD1306 Shape Function */
+
+// Integer only, drawn as horizontal or vertical runs with ssd1306_fill_rect_rop() and the current raster op
+// Every pixel is written once, SSD1306_ROP_XOR shapes drawn twice restore the screen
+// Parts off the screen or outside the clip rectangle are cut
+
+// Bresenham line, shallow lines as row runs, steep lines as column runs (one masked byte per page)
+// width : pixels across the minor axis, centered on the line
+void ssd1306_draw_line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+void ssd1306_draw_line_thick(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t width);
+
+// Center x, y, outline and filled
+// width : ring of width pixels inside the outline
+void ssd1306_draw_circle(uint8_t x, uint8_t y, uint8_t r);
+void ssd1306_draw_circle_thick(uint8_t x, uint8_t y, uint8_t r, uint8_t width);
+void ssd1306_fill_circle(uint8_t x, uint8_t y, uint8_t r);
+
+void ssd1306_draw_ellipse(uint8_t x, uint8_t y, uint8_t rx, uint8_t ry);
+void ssd1306_draw_ellipse_thick(uint8_t x, uint8_t y, uint8_t rx, uint8_t ry, uint8_t width);
+void ssd1306_fill_ellipse(uint8_t x, uint8_t y, uint8_t rx, uint8_t ry);
+
+// Top left x, y, corner radius r, cut to half of the shorter side, r = 0 : plain rectangle
+void ssd1306_draw_round_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t r);
+void ssd1306_draw_round_rect_thick(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t r, uint8_t width);
+void ssd1306_fill_round_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t r);
+
+
+#endif /* __SSD1306_SHAPE_H__ */
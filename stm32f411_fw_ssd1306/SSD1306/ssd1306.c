@@ -8,330 +8,2439 @@
 
 
 #include "ssd1306.h"
-#include <string.h> // memcpy
+#include <string.h> // memcpy, memset
+#include <stdint.h> // uintptr_t
 
 /* SSD1306 Variable */
-static uint8_t ssd1306_buffer[SSD1306_BUFFER_SIZE];
+// Zero-copy layout : control byte sits right before the buffer, buffer stays word aligned
+#if defined(SSD1306_USE_EXTERNAL_BUFFER)
+static uint8_t* ssd1306_buffer;
+#else
+static uint8_t ssd1306_frame[SSD1306_FRAME_SIZE] __attribute__((aligned(4)));
+static uint8_t* ssd1306_buffer = &ssd1306_frame[SSD1306_BUFFER_OFFSET];
+#endif
+static uint16_t lit_pixels;     // kept up to date by every buffer write
+static uint8_t lit_stale;       // bulk copy into buffer, recount on next read
 static SSD1306_CURSOR cursor;
+static uint8_t raster_op;       // SSD1306_ROP_SET after reset
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+static uint8_t band_page;       // page held in the buffer while streaming
+#else
+static const uint8_t band_page = 0;
+#endif
+
+// Clip stack in panel coordinates, view : top of stack cut to the pages held in the buffer
+static SSD1306_CLIP clip_stack[SSD1306_CLIP_DEPTH] = {{0, 0, SSD1306_WIDTH, SSD1306_HEIGHT}};
+static uint8_t clip_depth;
+static SSD1306_CLIP view = {0, 0, SSD1306_WIDTH, SSD1306_BUFFER_PAGES * 8};
+static int16_t origin_x, origin_y;
 SSD1306_FONT current_font;
 
+static SSD1306_TRANSFER transfer_queue[SSD1306_TRANSFER_QUEUE_SIZE];
+static volatile uint8_t transfer_head;
+static volatile uint8_t transfer_tail;
+static volatile uint8_t transfer_busy;
+
+static SSD1306_STATS stats;
+static volatile uint8_t boot_pending;
+static uint32_t sleep_time;
+static uint32_t frame_start;
+static volatile uint8_t frame_async;    // async flush in flight, the last completion closes its stats
+
+static SSD1306_STATE state;
+static uint8_t replay_sequence[SSD1306_STATE_SEQUENCE_SIZE];
+static uint32_t heartbeat_tick;
+
+static volatile uint8_t detached;
+static volatile uint8_t fail_count;
+static volatile uint8_t recovery_pending;
+static uint32_t probe_tick;
+
+static uint8_t power_state;
+static uint8_t active_contrast;
+static uint32_t activity_tick;
+static uint32_t shift_tick;
+static uint8_t shift_step;
+static uint8_t shift_x;
+static const uint8_t* shown_columns;    // column-major frame on the panel, NULL : frame buffer
+static uint8_t shift_window[6];
+static uint8_t shift_blank_window[6];
+static const uint8_t shift_blank[SSD1306_SHIFT_MAX * SSD1306_PAGE];
+
+static uint8_t lit_heavy;
+
+static uint8_t dirty_valid;
+#if defined(SSD1306_USE_DIRTY_CRC) && !defined(SSD1306_USE_PAGE_STREAMING)
+static uint32_t dirty_crc[SSD1306_DIRTY_TILES];
+static uint8_t dirty_window[SSD1306_DIRTY_RUNS][6];  // queued windows stay valid until sent
+#endif
+
+#if !defined(SSD1306_USE_PAGE_STREAMING)
+static uint8_t region_window[6];
+#endif
+
+
+/* SSD1306 Init Sequence */
+// SSD1306 App Note 5p, sent as one command transaction
+static const uint8_t ssd1306_init_sequence[] =
+{
+    SET_MULTIPLEX_RATIO, 63,
+    SET_DISPLAY_OFFSET, 0,
+    0x40,                                           // display start line 0
+    0xA1,                                           // segment remap
+    0xC8,                                           // com output scan direction remapped
+    SET_COM_PINS_HARDWARE_CONFIG, 0x12,             // alternative, no left/right remap
+    SET_CONTRAST_CONTROL, 0x7F,
+    ENTIRE_DISPLAY_OFF,
+    SET_NORMAL_DISPLAY,
+    SET_DISPLAY_CLOCK_DIVIDE_RATIO_AND_OSC_FREQ, 0x80,
+    CHARGE_BUMP_SETTING, 0x14,
+    SET_MEMORY_ADDRESSING_MODE, 0x00,               // horizontal, whole frame in one data transaction
+    SET_COLUMN_ADDRESS, 0, SSD1306_WIDTH - 1,
+    SET_PAGE_ADDRESS, 0, SSD1306_PAGE - 1,
+    SET_DISPLAY_ON
+};
+
+// Register values set by ssd1306_init_sequence
+static const SSD1306_STATE ssd1306_init_state =
+{
+    .charge_pump = 0x14,
+    .contrast = 0x7F,
+    .entire_display = ENTIRE_DISPLAY_OFF,
+    .inverse = SET_NORMAL_DISPLAY,
+    .display = SET_DISPLAY_ON,
+    .addressing_mode = 0x00,
+    .start_line = 0x40,
+    .segment_remap = 0xA1,
+    .multiplex_ratio = 63,
+    .com_scan_direction = 0xC8,
+    .display_offset = 0,
+    .com_pins = 0x12,
+    .clock = 0x80,
+    .pre_charge = 0x22,
+    .vcomh = 0x20
+};
+
+// Full screen window, sent before every frame
+static const uint8_t ssd1306_frame_window[] =
+{
+    SET_COLUMN_ADDRESS, 0, SSD1306_WIDTH - 1,
+    SET_PAGE_ADDRESS, 0, SSD1306_PAGE - 1
+};
+
+
+static void ssd1306_clip_view();
+
+
+/* I2C Write Function */
+// Single owner of the bus result, counts errors and detaches on repeated failure
+static void ssd1306_transfer_result(HAL_StatusTypeDef status)
+{
+    if(status == HAL_OK)
+    {
+        fail_count = 0;
+        return;
+    }
+
+    stats.error_count++;
+
+    if(status == HAL_ERROR && (SSD1306_I2C->ErrorCode & HAL_I2C_ERROR_AF))
+    {
+        // Slave address NACK, display absent or unpowered
+        stats.nack_count++;
+    }
+    else
+    {
+        // Bus busy, timeout or bus error, SDA may be held low
+        recovery_pending = 1;
+    }
+
+    if(++fail_count >= SSD1306_FAIL_LIMIT && !detached)
+    {
+        detached = 1;
+        probe_tick = HAL_GetTick();
+        stats.detach_count++;
+    }
+}
+
+static HAL_StatusTypeDef ssd1306_write(uint8_t control, const uint8_t* buffer, uint16_t size)
+{
+    HAL_StatusTypeDef status;
+
+    ssd1306_wait_idle();
+
+    if(detached)
+        return HAL_ERROR;
+
+    if(recovery_pending)
+        ssd1306_bus_recovery();
+
+    if(control == SSD1306_CONTROL_BYTE_NONE)
+        status = HAL_I2C_Master_Transmit(SSD1306_I2C, SSD1306_I2C_SA_WRITE, (uint8_t*)buffer, size, SSD1306_I2C_TIMEOUT);
+    else
+        status = HAL_I2C_Mem_Write(SSD1306_I2C, SSD1306_I2C_SA_WRITE, control, 1, (uint8_t*)buffer, size, SSD1306_I2C_TIMEOUT);
+
+    ssd1306_transfer_result(status);
+
+    return status;
+}
+
+HAL_StatusTypeDef ssd1306_write_command(uint8_t command)
+{
+    return ssd1306_write(SSD1306_CONTROL_BYTE_COMMAND, &command, 1);
+}
+
+HAL_StatusTypeDef ssd1306_write_data(uint8_t* buffer, uint16_t size)
+{
+    return ssd1306_write(SSD1306_CONTROL_BYTE_DATA, buffer, size);
+}
+
+HAL_StatusTypeDef ssd1306_write_commands(const uint8_t* buffer, uint16_t size)
+{
+    return ssd1306_write(SSD1306_CONTROL_BYTE_COMMAND, buffer, size);
+}
+
+
+/* Presence & Recovery */
+static void ssd1306_recovery_delay()
+{
+    // About half an SCL period at 100 kHz
+    for(volatile uint32_t i = 0; i < SSD1306_RECOVERY_DELAY; i++);
+}
+
+HAL_StatusTypeDef ssd1306_probe()
+{
+    HAL_StatusTypeDef status;
+
+    ssd1306_wait_idle();
+
+    if(recovery_pending)
+        ssd1306_bus_recovery();
+
+    status = HAL_I2C_IsDeviceReady(SSD1306_I2C, SSD1306_I2C_SA_WRITE, SSD1306_PROBE_TRIALS, SSD1306_PROBE_TIMEOUT);
+
+    if(status == HAL_BUSY || status == HAL_TIMEOUT)
+        recovery_pending = 1;
+
+    return status;
+}
+
+void ssd1306_bus_recovery()
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    recovery_pending = 0;
+    stats.recovery_count++;
+
+    // Release pins from I2C peripheral, GPIO clock stays enabled
+    HAL_I2C_DeInit(SSD1306_I2C);
+
+    HAL_GPIO_WritePin(SSD1306_SCL_PORT, SSD1306_SCL_PIN, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(SSD1306_SDA_PORT, SSD1306_SDA_PIN, GPIO_PIN_SET);
+
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    GPIO_InitStruct.Pin = SSD1306_SCL_PIN;
+    HAL_GPIO_Init(SSD1306_SCL_PORT, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = SSD1306_SDA_PIN;
+    HAL_GPIO_Init(SSD1306_SDA_PORT, &GPIO_InitStruct);
+
+    ssd1306_recovery_delay();
+
+    // Clock out the byte a slave is still sending, up to 9 clocks
+    for(int i = 0; i < 9 && HAL_GPIO_ReadPin(SSD1306_SDA_PORT, SSD1306_SDA_PIN) == GPIO_PIN_RESET; i++)
+    {
+        HAL_GPIO_WritePin(SSD1306_SCL_PORT, SSD1306_SCL_PIN, GPIO_PIN_RESET);
+        ssd1306_recovery_delay();
+        HAL_GPIO_WritePin(SSD1306_SCL_PORT, SSD1306_SCL_PIN, GPIO_PIN_SET);
+        ssd1306_recovery_delay();
+    }
+
+    // STOP condition : SDA rises while SCL is high
+    HAL_GPIO_WritePin(SSD1306_SCL_PORT, SSD1306_SCL_PIN, GPIO_PIN_RESET);
+    ssd1306_recovery_delay();
+    HAL_GPIO_WritePin(SSD1306_SDA_PORT, SSD1306_SDA_PIN, GPIO_PIN_RESET);
+    ssd1306_recovery_delay();
+    HAL_GPIO_WritePin(SSD1306_SCL_PORT, SSD1306_SCL_PIN, GPIO_PIN_SET);
+    ssd1306_recovery_delay();
+    HAL_GPIO_WritePin(SSD1306_SDA_PORT, SSD1306_SDA_PIN, GPIO_PIN_SET);
+    ssd1306_recovery_delay();
+
+    // MspInit restores alternate function, init clears a stuck BUSY flag by software reset
+    HAL_I2C_Init(SSD1306_I2C);
+}
+
+uint8_t ssd1306_is_attached()
+{
+    return !detached;
+}
+
+
+/* Transfer Queue */
+static HAL_StatusTypeDef ssd1306_transfer_start(const SSD1306_TRANSFER* transfer)
+{
+    // Control byte is part of the buffer, no memory address phase
+    if(transfer->control == SSD1306_CONTROL_BYTE_NONE)
+    {
+#if defined(SSD1306_USE_DMA)
+        return HAL_I2C_Master_Transmit_DMA(SSD1306_I2C, SSD1306_I2C_SA_WRITE, (uint8_t*)transfer->buffer, transfer->size);
+#elif defined(SSD1306_USE_IT)
+        return HAL_I2C_Master_Transmit_IT(SSD1306_I2C, SSD1306_I2C_SA_WRITE, (uint8_t*)transfer->buffer, transfer->size);
+#else
+        return HAL_I2C_Master_Transmit(SSD1306_I2C, SSD1306_I2C_SA_WRITE, (uint8_t*)transfer->buffer, transfer->size, SSD1306_I2C_TIMEOUT);
+#endif
+    }
+
+#if defined(SSD1306_USE_DMA)
+    return HAL_I2C_Mem_Write_DMA(SSD1306_I2C, SSD1306_I2C_SA_WRITE, transfer->control, 1, (uint8_t*)transfer->buffer, transfer->size);
+#elif defined(SSD1306_USE_IT)
+    return HAL_I2C_Mem_Write_IT(SSD1306_I2C, SSD1306_I2C_SA_WRITE, transfer->control, 1, (uint8_t*)transfer->buffer, transfer->size);
+#else
+    return HAL_I2C_Mem_Write(SSD1306_I2C, SSD1306_I2C_SA_WRITE, transfer->control, 1, (uint8_t*)transfer->buffer, transfer->size, SSD1306_I2C_TIMEOUT);
+#endif
+}
+
+static void ssd1306_transfer_done(const SSD1306_TRANSFER* transfer)
+{
+    // First pixel data after init is on the panel
+    if(boot_pending && transfer->control != SSD1306_CONTROL_BYTE_COMMAND)
+    {
+        stats.boot_time = ssd1306_get_timestamp() - stats.init_start;
+        boot_pending = 0;
+    }
+}
+
+HAL_StatusTypeDef ssd1306_queue_transfer(uint8_t control, const uint8_t* buffer, uint16_t size)
+{
+#if defined(SSD1306_USE_DMA) || defined(SSD1306_USE_IT)
+    uint8_t next = (transfer_tail + 1) % SSD1306_TRANSFER_QUEUE_SIZE;
+    uint8_t start = 0;
+    uint32_t primask;
+    HAL_StatusTypeDef status = HAL_OK;
+
+    if(detached)
+        return HAL_ERROR;
+
+    // Queue full, wait for the interrupt to free a slot
+    while(next == transfer_head);
+
+    transfer_queue[transfer_tail].control = control;
+    transfer_queue[transfer_tail].buffer = buffer;
+    transfer_queue[transfer_tail].size = size;
+
+    // Completion interrupt must not see the queue between tail update and busy check
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    transfer_tail = next;
+
+    if(!transfer_busy)
+    {
+        transfer_busy = 1;
+        start = 1;
+    }
+
+    __set_PRIMASK(primask);
+
+    if(start)
+    {
+        if(recovery_pending)
+            ssd1306_bus_recovery();
+
+        status = ssd1306_transfer_start(&transfer_queue[transfer_head]);
+
+        if(status != HAL_OK)
+        {
+            transfer_head = transfer_tail;
+            transfer_busy = 0;
+            ssd1306_transfer_result(status);
+        }
+    }
+
+    return status;
+#else
+    SSD1306_TRANSFER transfer = {control, buffer, size};
+    HAL_StatusTypeDef status = ssd1306_write(control, buffer, size);
+
+    if(status == HAL_OK)
+        ssd1306_transfer_done(&transfer);
+
+    return status;
+#endif
+}
+
+// Flush statistics, start to last transfer done and WFI time in between
+static void ssd1306_frame_begin()
+{
+    frame_async = 0;
+    frame_start = ssd1306_get_timestamp();
+    sleep_time = 0;
+}
+
+static void ssd1306_frame_end()
+{
+    stats.frame_time = ssd1306_get_timestamp() - frame_start;
+    stats.frame_sleep_time = sleep_time;
+    frame_async = 0;
+}
+
+// Async flush queued, closed here when already done else by the completion interrupt
+static HAL_StatusTypeDef ssd1306_frame_queued(HAL_StatusTypeDef status)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    if(transfer_busy)
+        frame_async = 1;
+    else
+        ssd1306_frame_end();
+
+    __set_PRIMASK(primask);
+
+    return status;
+}
+
+uint8_t ssd1306_is_busy()
+{
+    return transfer_busy;
+}
+
+void ssd1306_wait_idle()
+{
+#if defined(SSD1306_USE_SLEEP) && (defined(SSD1306_USE_DMA) || defined(SSD1306_USE_IT))
+    uint32_t primask;
+#if defined(SSD1306_USE_SLEEP_STATS)
+    uint32_t start;
+#endif
+
+    if(!transfer_busy)
+        return;
+
+    ssd1306_sleep_begin();
+
+    // Check and sleep with interrupts masked, a pending completion still wakes WFI
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    while(transfer_busy)
+    {
+#if defined(SSD1306_USE_SLEEP_STATS)
+        start = ssd1306_get_timestamp();
+        __WFI();
+        sleep_time += ssd1306_get_timestamp() - start;
+#else
+        __WFI();
+#endif
+
+        // Let the completion interrupt run
+        __set_PRIMASK(primask);
+        __disable_irq();
+    }
+
+    __set_PRIMASK(primask);
+
+    ssd1306_sleep_end();
+#else
+    while(transfer_busy);
+#endif
+}
+
+__weak void ssd1306_sleep_begin()
+{
+}
+
+__weak void ssd1306_sleep_end()
+{
+}
+
+void ssd1306_i2c_tx_cplt_callback(I2C_HandleTypeDef *hi2c)
+{
+    if(hi2c != SSD1306_I2C || !transfer_busy)
+        return;
+
+    ssd1306_transfer_result(HAL_OK);
+    ssd1306_transfer_done(&transfer_queue[transfer_head]);
+
+    transfer_head = (transfer_head + 1) % SSD1306_TRANSFER_QUEUE_SIZE;
+
+    if(transfer_head == transfer_tail)
+    {
+        transfer_busy = 0;
+
+        if(frame_async)
+            ssd1306_frame_end();
+    }
+    else
+    {
+        HAL_StatusTypeDef status = ssd1306_transfer_start(&transfer_queue[transfer_head]);
+
+        if(status != HAL_OK)
+        {
+            // Drop the rest, next frame sends everything again
+            transfer_head = transfer_tail;
+            transfer_busy = 0;
+            ssd1306_transfer_result(status);
+
+            if(frame_async)
+                ssd1306_frame_end();
+        }
+    }
+}
+
+void ssd1306_i2c_error_callback(I2C_HandleTypeDef *hi2c)
+{
+    if(hi2c != SSD1306_I2C)
+        return;
+
+    transfer_head = transfer_tail;
+    transfer_busy = 0;
+
+    // Bus recovery runs from thread context on the next transfer
+    ssd1306_transfer_result(HAL_ERROR);
+
+    if(frame_async)
+        ssd1306_frame_end();
+}
+
+
+/* Frame */
+// Whole buffer in one data transaction
+static HAL_StatusTypeDef ssd1306_queue_buffer()
+{
+#if defined(SSD1306_USE_ZERO_COPY)
+    ssd1306_buffer[-1] = SSD1306_CONTROL_BYTE_DATA;
+
+    return ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_NONE, &ssd1306_buffer[-1], SSD1306_BUFFER_SIZE + 1);
+#else
+    return ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_DATA, ssd1306_buffer, SSD1306_BUFFER_SIZE);
+#endif
+}
+
+// Frame window, shifted right by shift_x columns for burn-in protection
+static HAL_StatusTypeDef ssd1306_queue_frame_window()
+{
+    HAL_StatusTypeDef status;
+
+    if(shift_x == 0)
+        return ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_COMMAND, ssd1306_frame_window, sizeof(ssd1306_frame_window));
+
+    // Blank the columns left of the frame
+    status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_COMMAND, shift_blank_window, sizeof(shift_blank_window));
+
+    if(status == HAL_OK)
+        status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_DATA, shift_blank, shift_x * SSD1306_PAGE);
+
+    if(status == HAL_OK)
+        status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_COMMAND, shift_window, sizeof(shift_window));
+
+    return status;
+}
+
+// Pages held in the buffer, sent under the frame window
+static HAL_StatusTypeDef ssd1306_queue_pages()
+{
+    HAL_StatusTypeDef status = HAL_OK;
+
+    if(shift_x == 0)
+        return ssd1306_queue_buffer();
+
+    // Window wraps at column 127, send each page without its last shift_x columns
+    for(int i = 0; i < SSD1306_BUFFER_PAGES && status == HAL_OK; i++)
+        status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_DATA, &ssd1306_buffer[SSD1306_WIDTH * i], SSD1306_WIDTH - shift_x);
+
+    return status;
+}
+
+// Whole buffer
+static HAL_StatusTypeDef ssd1306_queue_frame()
+{
+    HAL_StatusTypeDef status;
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    // Only one page in memory, see ssd1306_stream_frame()
+    return HAL_ERROR;
+#endif
+
+    // Panel gets the whole buffer, dirty checksums are recomputed on next dirty flush
+    dirty_valid = 0;
+    shown_columns = NULL;
+
+    status = ssd1306_queue_frame_window();
+
+    if(status == HAL_OK)
+        status = ssd1306_queue_pages();
+
+    return status;
+}
+
+
+static HAL_StatusTypeDef ssd1306_queue_vertical(const uint8_t* columns);
+
+
+/* Charge Bump Setting */
+HAL_StatusTypeDef charge_bump_setting(uint8_t charge_bump)
+{
+    uint8_t command[] = {CHARGE_BUMP_SETTING, charge_bump};
+
+    state.charge_pump = charge_bump;
+
+    return ssd1306_write_commands(command, sizeof(command));
+}
+
+/* Fundamental */
+HAL_StatusTypeDef set_contrast_control(uint8_t value)
+{
+    uint8_t command[] = {SET_CONTRAST_CONTROL, value};
+
+    state.contrast = value;
+
+    return ssd1306_write_commands(command, sizeof(command));
+}
+
+HAL_StatusTypeDef entire_display_off()
+{
+    state.entire_display = ENTIRE_DISPLAY_OFF;
+
+    return ssd1306_write_command(ENTIRE_DISPLAY_OFF);
+}
+
+HAL_StatusTypeDef entire_display_on()
+{
+    state.entire_display = ENTIRE_DISPLAY_ON;
+
+    return ssd1306_write_command(ENTIRE_DISPLAY_ON);
+}
+
+HAL_StatusTypeDef set_normal_display()
+{
+    state.inverse = SET_NORMAL_DISPLAY;
+
+    return ssd1306_write_command(SET_NORMAL_DISPLAY);
+}
+
+HAL_StatusTypeDef set_inverse_display()
+{
+    state.inverse = SET_INVERSE_DISPLAY;
+
+    return ssd1306_write_command(SET_INVERSE_DISPLAY);
+}
+
+HAL_StatusTypeDef set_display_on()
+{
+    state.display = SET_DISPLAY_ON;
+
+    return ssd1306_write_command(SET_DISPLAY_ON);
+}
+
+HAL_StatusTypeDef set_display_off()
+{
+    state.display = SET_DISPLAY_OFF;
+
+    return ssd1306_write_command(SET_DISPLAY_OFF);
+}
+
+
+/* Scrolling Command */
+// 안써용~
+
+
+/* Addressing Setting */
+HAL_StatusTypeDef set_lower_column_start_address_for_page_addressing_mode(uint8_t addr)
+{
+    return ssd1306_write_command(addr);
+}
+
+HAL_StatusTypeDef set_higher_column_start_address_for_page_addressing_mode(uint8_t addr)
+{
+    return ssd1306_write_command(addr);
+}
+
+HAL_StatusTypeDef set_memory_addressing_mode(uint8_t mode)
+{
+    uint8_t command[] = {SET_MEMORY_ADDRESSING_MODE, mode};
+
+    state.addressing_mode = mode;
+
+    return ssd1306_write_commands(command, sizeof(command));
+}
+
+HAL_StatusTypeDef set_column_address(uint8_t start, uint8_t end)
+{
+    uint8_t command[] = {SET_COLUMN_ADDRESS, start, end};
+
+    return ssd1306_write_commands(command, sizeof(command));
+}
+
+HAL_StatusTypeDef set_page_address(uint8_t start, uint8_t end)
+{
+    uint8_t command[] = {SET_PAGE_ADDRESS, start, end};
+
+    return ssd1306_write_commands(command, sizeof(command));
+}
+
+HAL_StatusTypeDef set_page_start_address_for_page_addressing_mode(uint8_t page)  // 0xB0(page0) ~ 0xB7(page7)
+{
+    return ssd1306_write_command(page);
+}
+
+
+/* Hardware Configuration */
+HAL_StatusTypeDef set_display_start_line(uint8_t start_line)
+{
+    state.start_line = start_line;
+
+    return ssd1306_write_command(start_line);
+}
+
+HAL_StatusTypeDef set_segment_remap(uint8_t mapping)
+{
+    state.segment_remap = mapping;
+
+    return ssd1306_write_command(mapping);
+}
+
+HAL_StatusTypeDef set_multiplex_ratio(uint8_t mux)
+{
+    uint8_t command[] = {SET_MULTIPLEX_RATIO, mux};
+
+    state.multiplex_ratio = mux;
+
+    return ssd1306_write_commands(command, sizeof(command));
+}
+
+HAL_StatusTypeDef set_com_output_scan_direction(uint8_t mode)
+{
+    state.com_scan_direction = mode;
+
+    return ssd1306_write_command(mode);
+}
+
+HAL_StatusTypeDef set_display_offset(uint8_t vertical_shift)
+{
+    uint8_t command[] = {SET_DISPLAY_OFFSET, vertical_shift};
+
+    state.display_offset = vertical_shift;
+
+    return ssd1306_write_commands(command, sizeof(command));
+}
+
+HAL_StatusTypeDef set_com_pins_hardware_config(uint8_t com_pin_config, uint8_t com_left_right_remap)
+{
+    uint8_t buffer = 0x02 | (com_pin_config << 4) | (com_left_right_remap << 5);
+    uint8_t command[] = {SET_COM_PINS_HARDWARE_CONFIG, buffer};
+
+    state.com_pins = buffer;
+
+    return ssd1306_write_commands(command, sizeof(command));
+}
+
+
+/* Timing & Driving Scheme Setting */
+HAL_StatusTypeDef set_display_clock_divide_ratio_and_osc_freq(uint8_t divide_ratio, uint8_t osc_freq)
+{
+    uint8_t buffer = (osc_freq << 4) | divide_ratio;
+    uint8_t command[] = {SET_DISPLAY_CLOCK_DIVIDE_RATIO_AND_OSC_FREQ, buffer};
+
+    state.clock = buffer;
+
+    return ssd1306_write_commands(command, sizeof(command));
+}
+
+HAL_StatusTypeDef set_pre_charge_period(uint8_t phase_1, uint8_t phase_2)
+{
+    uint8_t buffer = (phase_2 << 4) | phase_1;
+    uint8_t command[] = {SET_PRE_CHARGE_PERIOD, buffer};
+
+    state.pre_charge = buffer;
+
+    return ssd1306_write_commands(command, sizeof(command));
+}
+
+HAL_StatusTypeDef set_v_comh_deselect_level(uint8_t deselect_level)
+{
+    uint8_t command[] = {SET_V_COMH_DESELECT_LEVEL, deselect_level};
+
+    state.vcomh = deselect_level;
+
+    return ssd1306_write_commands(command, sizeof(command));
+}
+
+
+/* State Cache */
+// Replay cached registers, panel lost them on brownout or hot-plug
+// @return : sequence size
+static uint16_t ssd1306_build_state_sequence(uint8_t* buffer, uint8_t critical_only)
+{
+    uint16_t i = 0;
+
+    // Critical : wrong value garbles or blanks the whole panel
+    buffer[i++] = CHARGE_BUMP_SETTING;
+    buffer[i++] = state.charge_pump;
+    buffer[i++] = SET_MULTIPLEX_RATIO;
+    buffer[i++] = state.multiplex_ratio;
+    buffer[i++] = SET_DISPLAY_OFFSET;
+    buffer[i++] = state.display_offset;
+    buffer[i++] = state.start_line;
+    buffer[i++] = state.segment_remap;
+    buffer[i++] = state.com_scan_direction;
+    buffer[i++] = SET_COM_PINS_HARDWARE_CONFIG;
+    buffer[i++] = state.com_pins;
+    buffer[i++] = SET_MEMORY_ADDRESSING_MODE;
+    buffer[i++] = state.addressing_mode;
+
+    if(!critical_only)
+    {
+        buffer[i++] = SET_CONTRAST_CONTROL;
+        buffer[i++] = state.contrast;
+        buffer[i++] = state.entire_display;
+        buffer[i++] = state.inverse;
+        buffer[i++] = SET_DISPLAY_CLOCK_DIVIDE_RATIO_AND_OSC_FREQ;
+        buffer[i++] = state.clock;
+        buffer[i++] = SET_PRE_CHARGE_PERIOD;
+        buffer[i++] = state.pre_charge;
+        buffer[i++] = SET_V_COMH_DESELECT_LEVEL;
+        buffer[i++] = state.vcomh;
+    }
+
+    buffer[i++] = state.display;
+
+    return i;
+}
+
+const SSD1306_STATE* ssd1306_get_state()
+{
+    return &state;
+}
+
+HAL_StatusTypeDef ssd1306_resync()
+{
+    HAL_StatusTypeDef status;
+    uint16_t size;
+
+    // Replay buffer may still be in flight
+    ssd1306_wait_idle();
+
+    size = ssd1306_build_state_sequence(replay_sequence, 0);
+
+    status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_COMMAND, replay_sequence, size);
+
+    // Same source the panel showed last
+    if(status == HAL_OK && shown_columns != NULL)
+        status = ssd1306_queue_vertical(shown_columns);
+#if !defined(SSD1306_USE_PAGE_STREAMING)
+    else if(status == HAL_OK)
+        status = ssd1306_queue_frame();
+#endif
+
+    return status;
+}
+
+void ssd1306_heartbeat()
+{
+    uint32_t now = HAL_GetTick();
+    uint16_t size;
+
+    // Detached : re-probe, panel lost power so replay everything on return
+    if(detached)
+    {
+        if(now - probe_tick < SSD1306_REPROBE_PERIOD)
+            return;
+
+        probe_tick = now;
+
+        if(ssd1306_probe() == HAL_OK)
+        {
+            detached = 0;
+            fail_count = 0;
+            stats.attach_count++;
+
+            ssd1306_resync();
+        }
+
+        return;
+    }
+
+    if(SSD1306_HEARTBEAT_PERIOD == 0 || now - heartbeat_tick < SSD1306_HEARTBEAT_PERIOD)
+        return;
+
+    // Never stall the caller, try again on the next call
+    if(transfer_busy)
+        return;
+
+    heartbeat_tick = now;
+
+    size = ssd1306_build_state_sequence(replay_sequence, 1);
+
+    ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_COMMAND, replay_sequence, size);
+}
+
+
+/* SSD1306 Function */
+HAL_StatusTypeDef ssd1306_init()
+{
+    HAL_StatusTypeDef status = ssd1306_init_async(1);
+
+    ssd1306_wait_idle();
+
+    return status;
+}
+
+HAL_StatusTypeDef ssd1306_init_async(uint8_t clear_ram)
+{
+    HAL_StatusTypeDef status;
+
+    // No frame memory until ssd1306_attach_frame()
+    if(ssd1306_buffer == NULL)
+        return HAL_ERROR;
+
+#if defined(DWT)
+    // Enable cycle counter for statistics
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+#if defined(SSD1306_USE_SLEEP_STATS) && defined(DBGMCU_CR_DBG_SLEEP)
+    // Core clock keeps running in WFI so CYCCNT counts the sleep, without a debugger it would stop
+    DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;
+#endif
+
+    stats.init_start = ssd1306_get_timestamp();
+    stats.boot_time = 0;
+    boot_pending = 1;
+
+    state = ssd1306_init_state;
+    heartbeat_tick = HAL_GetTick();
+
+    power_state = SSD1306_POWER_ACTIVE;
+    active_contrast = state.contrast;
+    activity_tick = HAL_GetTick();
+    shift_tick = HAL_GetTick();
+    shift_step = 0;
+    shift_x = 0;
+    shown_columns = NULL;
+
+    // Clear buffer, first frame starts from black
+    memset(ssd1306_buffer, 0x00, SSD1306_BUFFER_SIZE);
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    band_page = 0;
+#endif
+    ssd1306_reset_clip();
+    lit_pixels = 0;
+    lit_stale = 0;
+    lit_heavy = 0;
+
+    // Set cursor 0, 0
+    ssd1306_set_cursor(0, 0);
+
+    // Fail fast when the display is absent, ssd1306_heartbeat() re-probes and resyncs
+    detached = 0;
+    fail_count = 0;
+
+    if(ssd1306_probe() != HAL_OK)
+    {
+        detached = 1;
+        probe_tick = HAL_GetTick();
+        stats.detach_count++;
+
+        return HAL_ERROR;
+    }
+
+    status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_COMMAND, ssd1306_init_sequence, sizeof(ssd1306_init_sequence));
+
+    // Clear Ram Data, window is already set by init sequence
+    // Streaming : the cleared page goes out once per page
+    for(int i = 0; i < SSD1306_PAGE / SSD1306_BUFFER_PAGES && status == HAL_OK && clear_ram; i++)
+        status = ssd1306_queue_buffer();
+
+    return status;
+}
+
+HAL_StatusTypeDef ssd1306_update_screen()
+{
+    HAL_StatusTypeDef status;
+
+    ssd1306_frame_begin();
+
+    status = ssd1306_queue_frame();
+
+    ssd1306_wait_idle();
+    ssd1306_frame_end();
+
+    return status;
+}
+
+HAL_StatusTypeDef ssd1306_update_screen_async()
+{
+    ssd1306_frame_begin();
+
+    return ssd1306_frame_queued(ssd1306_queue_frame());
+}
+
+// Column-major frame, vertical addressing mode walks pages first, then columns
+static HAL_StatusTypeDef ssd1306_queue_vertical(const uint8_t* columns)
+{
+    static const uint8_t vertical_mode[] = {SET_MEMORY_ADDRESSING_MODE, 0x01};
+    static const uint8_t horizontal_mode[] = {SET_MEMORY_ADDRESSING_MODE, 0x00};
+    HAL_StatusTypeDef status;
+
+    // Panel no longer shows the frame buffer, dirty checksums are recomputed on next dirty flush
+    // Burn-in shift and resync replay these columns
+    dirty_valid = 0;
+    shown_columns = columns;
+
+    status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_COMMAND, vertical_mode, sizeof(vertical_mode));
+
+    // Same window as a page-major frame, burn-in shift drops the last shift_x columns in one piece
+    if(status == HAL_OK)
+        status = ssd1306_queue_frame_window();
+
+    if(status == HAL_OK)
+        status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_DATA, columns, (SSD1306_WIDTH - shift_x) * SSD1306_PAGE);
+
+    // Every other flush path expects horizontal mode
+    if(status == HAL_OK)
+        status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_COMMAND, horizontal_mode, sizeof(horizontal_mode));
+
+    return status;
+}
+
+HAL_StatusTypeDef ssd1306_update_screen_vertical(const uint8_t* columns)
+{
+    HAL_StatusTypeDef status;
+
+    ssd1306_frame_begin();
+
+    status = ssd1306_queue_vertical(columns);
+
+    ssd1306_wait_idle();
+    ssd1306_frame_end();
+
+    return status;
+}
+
+HAL_StatusTypeDef ssd1306_update_screen_vertical_async(const uint8_t* columns)
+{
+    ssd1306_frame_begin();
+
+    return ssd1306_frame_queued(ssd1306_queue_vertical(columns));
+}
+
+HAL_StatusTypeDef ssd1306_stream_frame(SSD1306_DRAW_CALLBACK draw, void* context)
+{
+    HAL_StatusTypeDef status;
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    SSD1306_CURSOR origin = cursor;
+    uint16_t lit_total = 0;
+#endif
+
+    ssd1306_frame_begin();
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    dirty_valid = 0;
+    shown_columns = NULL;
+
+    status = ssd1306_queue_frame_window();
+
+    // Window advances to the next page by itself, one data transaction per page
+    for(uint8_t page = 0; page < SSD1306_PAGE && status == HAL_OK; page++)
+    {
+        // Previous page is still being sent from the same memory
+        ssd1306_wait_idle();
+
+        band_page = page;
+        ssd1306_clip_view();
+        memset(ssd1306_buffer, 0x00, SSD1306_BUFFER_SIZE);
+        lit_pixels = 0;
+        lit_stale = 0;
+        cursor = origin;
+
+        draw(context);
+
+        lit_total += ssd1306_get_lit_pixels();
+
+        status = ssd1306_queue_pages();
+    }
+
+    ssd1306_wait_idle();
+
+    // Lit count covers the whole frame, not the last page
+    lit_pixels = lit_total;
+    lit_stale = 0;
+#else
+    memset(ssd1306_buffer, 0x00, SSD1306_BUFFER_SIZE);
+    lit_pixels = 0;
+    lit_stale = 0;
+
+    draw(context);
+
+    status = ssd1306_queue_frame();
+
+    ssd1306_wait_idle();
+#endif
+
+    ssd1306_frame_end();
+
+    return status;
+}
+
+
+/* Region Update */
+#if defined(SSD1306_USE_PAGE_STREAMING)
+// Only one page in memory
+static HAL_StatusTypeDef ssd1306_queue_region(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    return HAL_ERROR;
+}
+#else
+static void ssd1306_dirty_sent(uint8_t x, uint8_t page, uint8_t width, uint8_t pages);
+
+static HAL_StatusTypeDef ssd1306_queue_region(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    HAL_StatusTypeDef status;
+    uint8_t page, pages, column;
+
+    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT || w == 0 || h == 0)
+        return HAL_OK;
+
+    if(w > SSD1306_WIDTH - x)
+        w = SSD1306_WIDTH - x;
+
+    if(h > SSD1306_HEIGHT - y)
+        h = SSD1306_HEIGHT - y;
+
+    // Round to whole pages
+    page = y / 8;
+    pages = (y + h + 7) / 8 - page;
+
+    // Burn-in shift moves the frame right, last columns fall off
+    column = x + shift_x;
+
+    if(column >= SSD1306_WIDTH)
+        return HAL_OK;
+
+    if(w > SSD1306_WIDTH - column)
+        w = SSD1306_WIDTH - column;
+
+    // Window of the previous region may still be in flight
+    ssd1306_wait_idle();
+
+    shown_columns = NULL;
+
+    region_window[0] = SET_COLUMN_ADDRESS;
+    region_window[1] = column;
+    region_window[2] = column + w - 1;
+    region_window[3] = SET_PAGE_ADDRESS;
+    region_window[4] = page;
+    region_window[5] = page + pages - 1;
+
+    status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_COMMAND, region_window, sizeof(region_window));
+
+    if(w == SSD1306_WIDTH)
+    {
+        // Full width pages are contiguous, one data transaction
+        if(status == HAL_OK)
+            status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_DATA, &ssd1306_buffer[SSD1306_WIDTH * page], SSD1306_WIDTH * pages);
+    }
+    else
+    {
+        // Window wraps to the next page by itself, rows are w bytes apart in the buffer
+        for(uint8_t i = page; i < page + pages && status == HAL_OK; i++)
+            status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_DATA, &ssd1306_buffer[SSD1306_WIDTH * i + x], w);
+    }
+
+    if(status == HAL_OK)
+        ssd1306_dirty_sent(x, page, w, pages);
+    else
+        dirty_valid = 0;
+
+    return status;
+}
+#endif
+
+HAL_StatusTypeDef ssd1306_update_region(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    HAL_StatusTypeDef status;
+
+    ssd1306_frame_begin();
+
+    status = ssd1306_queue_region(x, y, w, h);
+
+    ssd1306_wait_idle();
+    ssd1306_frame_end();
+
+    return status;
+}
+
+HAL_StatusTypeDef ssd1306_update_region_async(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    ssd1306_frame_begin();
+
+    return ssd1306_frame_queued(ssd1306_queue_region(x, y, w, h));
+}
+
+
+/* Dirty Tile Detection */
+uint32_t ssd1306_crc32(const uint32_t* data, uint16_t words)
+{
+#if defined(CRC)
+    // CRC unit : CRC-32 poly 0x04C11DB7, init 0xFFFFFFFF, 32-bit words, no reflection
+    __HAL_RCC_CRC_CLK_ENABLE();
+
+    CRC->CR = CRC_CR_RESET;
+
+    for(uint16_t i = 0; i < words; i++)
+        CRC->DR = data[i];
+
+    return CRC->DR;
+#else
+    // Same result as the CRC unit, a nibble at a time
+    static const uint32_t table[16] =
+    {
+        0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
+        0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61, 0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD
+    };
+    uint32_t crc = 0xFFFFFFFF;
+
+    for(uint16_t i = 0; i < words; i++)
+    {
+        crc ^= data[i];
+
+        for(int j = 0; j < 8; j++)
+            crc = (crc << 4) ^ table[crc >> 28];
+    }
+
+    return crc;
+#endif
+}
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+// Only one page in memory
+static HAL_StatusTypeDef ssd1306_queue_dirty()
+{
+    return HAL_ERROR;
+}
+#elif !defined(SSD1306_USE_DIRTY_CRC)
+// No checksums kept, the whole frame goes out
+static HAL_StatusTypeDef ssd1306_queue_dirty()
+{
+    return ssd1306_queue_frame();
+}
+
+static void ssd1306_dirty_sent(uint8_t x, uint8_t page, uint8_t width, uint8_t pages)
+{
+}
+#else
+static HAL_StatusTypeDef ssd1306_queue_dirty()
+{
+    HAL_StatusTypeDef status = HAL_OK;
+    uint8_t runs = 0;
+
+    // Windows of the previous dirty flush may still be in flight
+    ssd1306_wait_idle();
+
+    shown_columns = NULL;
+
+    for(uint8_t page = 0; page < SSD1306_PAGE; page++)
+    {
+        uint8_t start = 0xFF;
+
+        // One step past the last tile closes an open run
+        for(uint8_t x = 0; x <= SSD1306_WIDTH; x += SSD1306_DIRTY_TILE_WIDTH)
+        {
+            uint8_t changed = 0;
+
+            if(x < SSD1306_WIDTH)
+            {
+                const uint32_t* data = (const uint32_t*)&ssd1306_buffer[SSD1306_WIDTH * page + x];
+                uint32_t crc = ssd1306_crc32(data, SSD1306_DIRTY_TILE_WIDTH / 4);
+                uint8_t tile = page * (SSD1306_WIDTH / SSD1306_DIRTY_TILE_WIDTH) + x / SSD1306_DIRTY_TILE_WIDTH;
+
+                changed = !dirty_valid || crc != dirty_crc[tile];
+                dirty_crc[tile] = crc;
+            }
+
+            if(changed && start == 0xFF)
+            {
+                start = x;
+            }
+            else if(!changed && start != 0xFF)
+            {
+                // Adjacent changed tiles of a page go in one window
+                uint8_t* window = dirty_window[runs++];
+                uint8_t column = start + shift_x;
+                uint8_t size = x - start;
+
+                if(column + size > SSD1306_WIDTH)
+                    size = SSD1306_WIDTH - column;
+
+                window[0] = SET_COLUMN_ADDRESS;
+                window[1] = column;
+                window[2] = column + size - 1;
+                window[3] = SET_PAGE_ADDRESS;
+                window[4] = page;
+                window[5] = page;
+
+                if(status == HAL_OK)
+                    status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_COMMAND, window, 6);
+
+                if(status == HAL_OK)
+                    status = ssd1306_queue_transfer(SSD1306_CONTROL_BYTE_DATA, &ssd1306_buffer[SSD1306_WIDTH * page + start], size);
+
+                stats.dirty_tiles += (x - start) / SSD1306_DIRTY_TILE_WIDTH;
+                start = 0xFF;
+            }
+        }
+    }
+
+    // Failed transfer left the panel behind, send everything next time
+    dirty_valid = (status == HAL_OK);
+
+    return status;
+}
+
+// Region went out without the dirty flush, keep checksums in line with the panel
+// Partly sent tiles get an inverted checksum so the next dirty flush re-sends them
+static void ssd1306_dirty_sent(uint8_t x, uint8_t page, uint8_t width, uint8_t pages)
+{
+    if(!dirty_valid)
+        return;
+
+    for(uint8_t p = page; p < page + pages; p++)
+    {
+        for(uint8_t t = x / SSD1306_DIRTY_TILE_WIDTH * SSD1306_DIRTY_TILE_WIDTH; t < x + width; t += SSD1306_DIRTY_TILE_WIDTH)
+        {
+            const uint32_t* data = (const uint32_t*)&ssd1306_buffer[SSD1306_WIDTH * p + t];
+            uint8_t tile = p * (SSD1306_WIDTH / SSD1306_DIRTY_TILE_WIDTH) + t / SSD1306_DIRTY_TILE_WIDTH;
+            uint32_t crc = ssd1306_crc32(data, SSD1306_DIRTY_TILE_WIDTH / 4);
+
+            dirty_crc[tile] = (t >= x && t + SSD1306_DIRTY_TILE_WIDTH <= x + width) ? crc : ~crc;
+        }
+    }
+}
+#endif
+
+HAL_StatusTypeDef ssd1306_update_screen_dirty()
+{
+    HAL_StatusTypeDef status;
+
+    ssd1306_frame_begin();
+
+    status = ssd1306_queue_dirty();
+
+    ssd1306_wait_idle();
+    ssd1306_frame_end();
+
+    return status;
+}
+
+HAL_StatusTypeDef ssd1306_update_screen_dirty_async()
+{
+    ssd1306_frame_begin();
+
+    return ssd1306_frame_queued(ssd1306_queue_dirty());
+}
+
+void ssd1306_black_screen()
+{
+    ssd1306_mem_fill(ssd1306_buffer, 0x00000000, SSD1306_BUFFER_SIZE);
+
+    lit_pixels = 0;
+
+    ssd1306_update_screen();
+}
+
+void ssd1306_white_screen()
+{
+    ssd1306_mem_fill(ssd1306_buffer, 0xFFFFFFFF, SSD1306_BUFFER_SIZE);
+
+    lit_pixels = SSD1306_BUFFER_SIZE * 8;
+
+    ssd1306_update_screen();
+}
+
+// Buffer byte of a local pixel, NULL outside the view
+// Origin moves the pixel, the view already holds the clip, the panel and the streamed page
+static inline SSD1306_RAM_FUNC uint8_t* ssd1306_pixel_byte(uint8_t x, uint8_t y, uint8_t* bit)
+{
+    int16_t sx = x + origin_x;
+    int16_t sy = y + origin_y;
+
+    if(sx < view.x0 || sx >= view.x1 || sy < view.y0 || sy >= view.y1)
+        return NULL;
+
+    // (sy / 8 - band_page) * SSD1306_WIDTH : page
+    // sy % 8 : data bit D0 - D7
+    *bit = sy % 8;
+
+    return &ssd1306_buffer[sx + (sy / 8 - band_page) * SSD1306_WIDTH];
+}
+
+SSD1306_RAM_FUNC void ssd1306_black_pixel(uint8_t x, uint8_t y)
+{
+    uint8_t bit;
+    uint8_t* byte = ssd1306_pixel_byte(x, y, &bit);
+
+    if(byte == NULL)
+        return;
+
+#if defined(SSD1306_BITBAND_ALIAS)
+    // One alias word per bit, a single store without read-modify-write of the byte
+    // Lit count is rebuilt on the next read instead of testing the bit first
+    *(volatile uint32_t*)(SSD1306_BITBAND_ALIAS + (((uintptr_t)byte - SSD1306_BITBAND_SRAM) << 5) + (bit << 2)) = 0;
+    lit_stale = 1;
+#else
+    if(*byte & (1 << bit))
+    {
+        *byte &= ~(1 << bit);
+        lit_pixels--;
+    }
+#endif
+}
+
+SSD1306_RAM_FUNC void ssd1306_white_pixel(uint8_t x, uint8_t y)
+{
+    uint8_t bit;
+    uint8_t* byte = ssd1306_pixel_byte(x, y, &bit);
+
+    if(byte == NULL)
+        return;
+
+#if defined(SSD1306_BITBAND_ALIAS)
+    // One alias word per bit, a single store without read-modify-write of the byte
+    // Lit count is rebuilt on the next read instead of testing the bit first
+    *(volatile uint32_t*)(SSD1306_BITBAND_ALIAS + (((uintptr_t)byte - SSD1306_BITBAND_SRAM) << 5) + (bit << 2)) = 1;
+    lit_stale = 1;
+#else
+    if(!(*byte & (1 << bit)))
+    {
+        *byte |= 1 << bit;
+        lit_pixels++;
+    }
+#endif
+}
+
+// Rows r - 7 and rows 0 - r of a page, ends of a vertical span
+static const uint8_t span_start_mask[8] = {0xFF, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80};
+static const uint8_t span_end_mask[8] = {0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF};
+
+// Byte or four byte lanes at once
+static inline SSD1306_RAM_FUNC uint32_t ssd1306_rop_value(uint32_t old, uint32_t set, uint32_t cover, uint8_t rop)
+{
+    switch(rop)
+    {
+        case SSD1306_ROP_OR:        return old | set;
+        case SSD1306_ROP_CLEAR:     return old & ~set;
+        case SSD1306_ROP_XOR:       return old ^ set;
+        case SSD1306_ROP_INVERT:    return (old & ~cover) | (cover & ~set);
+        default:                    return (old & ~cover) | set;
+    }
+}
+
+// Source bits in set, bits of the glyph cell or pixel in cover, lit count follows the byte
+static inline SSD1306_RAM_FUNC void ssd1306_rop_byte(uint8_t* byte, uint8_t set, uint8_t cover, uint8_t rop)
+{
+    uint8_t old = *byte;
+    uint8_t value = ssd1306_rop_value(old, set, cover, rop);
+
+    if(value != old)
+    {
+        *byte = value;
+        lit_pixels = lit_pixels + ssd1306_popcount32(value) - ssd1306_popcount32(old);
+    }
+}
+
+SSD1306_RAM_FUNC void ssd1306_draw_pixel_rop(uint8_t x, uint8_t y, uint8_t rop)
+{
+    uint8_t bit;
+    uint8_t* byte = ssd1306_pixel_byte(x, y, &bit);
+
+    if(byte != NULL)
+        ssd1306_rop_byte(byte, 1 << bit, 1 << bit, rop);
+}
+
+void ssd1306_draw_pixel(uint8_t x, uint8_t y)
+{
+    ssd1306_draw_pixel_rop(x, y, raster_op);
+}
+
+// Visible part of a w x h cell at local (x, y), in cell coordinates
+// @return : 0 when nothing is visible
+static SSD1306_RAM_FUNC uint8_t ssd1306_clip_cell(uint8_t x, uint8_t y, uint8_t w, uint8_t h, int16_t* sx, int16_t* sy, SSD1306_CLIP* cell)
+{
+    int16_t x0, y0, x1, y1;
+
+    *sx = x + origin_x;
+    *sy = y + origin_y;
+
+    // Clamped in 16 bits, far off-screen cells must not wrap into the 8-bit cell
+    x0 = view.x0 - *sx;
+    y0 = view.y0 - *sy;
+    x1 = view.x1 - *sx;
+    y1 = view.y1 - *sy;
+
+    if(x0 < 0)
+        x0 = 0;
+
+    if(y0 < 0)
+        y0 = 0;
+
+    if(x1 > w)
+        x1 = w;
+
+    if(y1 > h)
+        y1 = h;
+
+    if(x0 >= x1 || y0 >= y1)
+        return 0;
+
+    cell->x0 = x0;
+    cell->y0 = y0;
+    cell->x1 = x1;
+    cell->y1 = y1;
+
+    return 1;
+}
+
+SSD1306_RAM_FUNC char ssd1306_write_char_rop(SSD1306_FONT font, char ch, uint8_t rop)
+{
+    const uint16_t* glyph;
+    SSD1306_CLIP cell;
+    int16_t sx, sy;
+
+    // Printable Characters : 32 - 126
+    if(ch < 32 || ch > 126)
+        return 0;
+
+    // Clipped once, the loops below write only visible bytes, nothing visible : line is full
+    if(!ssd1306_clip_cell(cursor.x, cursor.y, font.width, font.height, &sx, &sy, &cell))
+        return 0;
+
+    glyph = &font.data[(ch - 32) * font.height];
+
+    // One read-modify-write per page byte of each glyph column
+    for(uint8_t j = cell.x0; j < cell.x1; j++)
+    {
+        uint8_t* column = &ssd1306_buffer[sx + j];
+        uint8_t page = (sy + cell.y0) / 8;
+        uint8_t set = 0, cover = 0;
+
+        for(uint8_t i = cell.y0; i < cell.y1; i++)
+        {
+            uint8_t y = sy + i;
+
+            if(y / 8 != page)
+            {
+                ssd1306_rop_byte(&column[(page - band_page) * SSD1306_WIDTH], set, cover, rop);
+
+                page = y / 8;
+                set = 0;
+                cover = 0;
+            }
+
+            cover |= 1 << (y % 8);
+
+            if((glyph[i] << j) & 0x8000)
+                set |= 1 << (y % 8);
+        }
+
+        ssd1306_rop_byte(&column[(page - band_page) * SSD1306_WIDTH], set, cover, rop);
+    }
+
+    // The current space is now taken
+    cursor.x += font.width;
+
+    // Return written char for validation
+    return ch;
+}
+
+char ssd1306_write_char(SSD1306_FONT font, char ch)
+{
+    return ssd1306_write_char_rop(font, ch, raster_op);
+}
+
+SSD1306_RAM_FUNC void ssd1306_draw_bitmap_rop(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t* bitmap, uint8_t rop)
+{
+    SSD1306_CLIP cell;
+    int16_t sx, sy;
+    uint8_t pages = (h + 7) / 8;
+
+    if(!ssd1306_clip_cell(x, y, w, h, &sx, &sy, &cell))
+        return;
+
+    for(uint8_t j = cell.x0; j < cell.x1; j++)
+    {
+        uint8_t* column = &ssd1306_buffer[sx + j];
+        uint8_t i = cell.y0;
+
+        // Page by page of the panel, source rows can straddle two bitmap bytes
+        while(i < cell.y1)
+        {
+            uint8_t y = sy + i;
+            uint8_t rows = 8 - y % 8;
+            uint8_t row = i / 8;
+            uint16_t source;
+            uint8_t cover;
+
+            if(rows > cell.y1 - i)
+                rows = cell.y1 - i;
+
+            source = bitmap[row * w + j];
+
+            if(row + 1 < pages)
+                source |= bitmap[(row + 1) * w + j] << 8;
+
+            cover = ((1 << rows) - 1) << (y % 8);
+
+            ssd1306_rop_byte(&column[(y / 8 - band_page) * SSD1306_WIDTH], ((source >> (i % 8)) << (y % 8)) & cover, cover, rop);
+
+            i += rows;
+        }
+    }
+}
 
-/* I2C Write Function */
-void ssd1306_write_command(uint8_t command)
+void ssd1306_draw_bitmap(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t* bitmap)
 {
-    HAL_I2C_Mem_Write(SSD1306_I2C, SSD1306_I2C_SA_WRITE, SSD1306_CONTROL_BYTE_COMMAND, 1, &command, 1, 1000);
+    ssd1306_draw_bitmap_rop(x, y, w, h, bitmap, raster_op);
 }
 
-void ssd1306_write_data(uint8_t* buffer, uint16_t size)
+// 8x8 patterns, one page byte per column, repeat from panel 0, 0 so neighbouring fills line up
+const uint8_t ssd1306_pattern_solid[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+const uint8_t ssd1306_pattern_checker[8] = {0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA};
+const uint8_t ssd1306_pattern_stipple[8] = {0x11, 0x00, 0x44, 0x00, 0x11, 0x00, 0x44, 0x00};
+const uint8_t ssd1306_pattern_hatch[8] = {0x11, 0x22, 0x44, 0x88, 0x11, 0x22, 0x44, 0x88};
+
+// count bytes of one page from panel column x, pattern bits under cover, aligned middle a word at a time
+static SSD1306_RAM_FUNC void ssd1306_rop_run(uint8_t* byte, uint8_t x, uint8_t count, const uint8_t* pattern, uint8_t cover, uint8_t rop)
 {
-    HAL_I2C_Mem_Write(SSD1306_I2C, SSD1306_I2C_SA_WRITE, SSD1306_CONTROL_BYTE_DATA, 1, buffer, size, 1000);
+    uint32_t* word;
+    uint32_t pattern_word[2];
+    uint32_t cover_word = cover * 0x01010101U;
+
+    for(; count > 0 && ((uintptr_t)byte & 3); count--, x++)
+        ssd1306_rop_byte(byte++, pattern[x % 8] & cover, cover, rop);
+
+    // Little-endian lanes : columns x to x + 3 of an aligned word
+    memcpy(pattern_word, pattern, sizeof(pattern_word));
+
+    for(word = (uint32_t*)byte; count >= 4; count -= 4, word++, x += 4)
+    {
+        uint32_t old = *word;
+        uint32_t value = ssd1306_rop_value(old, pattern_word[(x / 4) % 2] & cover_word, cover_word, rop);
+
+        if(value != old)
+        {
+            *word = value;
+            lit_pixels = lit_pixels + ssd1306_popcount32(value) - ssd1306_popcount32(old);
+        }
+    }
+
+    for(byte = (uint8_t*)word; count > 0; count--, x++)
+        ssd1306_rop_byte(byte++, pattern[x % 8] & cover, cover, rop);
 }
 
+// Visible part of a w x h box at local (x, y) as masked page runs
+// Lines, rectangles and span fills end here
+static SSD1306_RAM_FUNC void ssd1306_fill_box(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t* pattern, uint8_t rop)
+{
+    SSD1306_CLIP cell;
+    int16_t sx, sy;
+    uint8_t x0, y0, y1;
+
+    if(!ssd1306_clip_cell(x, y, w, h, &sx, &sy, &cell))
+        return;
 
-/* Charge Bump Setting */
-void charge_bump_setting(uint8_t charge_bump)
+    x0 = sx + cell.x0;
+    y0 = sy + cell.y0;
+    y1 = sy + cell.y1 - 1;
+
+    for(uint8_t page = y0 / 8; page <= y1 / 8; page++)
+    {
+        uint8_t mask = 0xFF;
+
+        if(page == y0 / 8)
+            mask &= span_start_mask[y0 % 8];
+
+        if(page == y1 / 8)
+            mask &= span_end_mask[y1 % 8];
+
+        ssd1306_rop_run(&ssd1306_buffer[x0 + (page - band_page) * SSD1306_WIDTH], x0, cell.x1 - cell.x0, pattern, mask, rop);
+    }
+}
+
+void ssd1306_draw_hline_rop(uint8_t x, uint8_t y, uint8_t w, uint8_t rop)
 {
-    ssd1306_write_command(CHARGE_BUMP_SETTING);
-    ssd1306_write_command(charge_bump);
+    ssd1306_fill_box(x, y, w, 1, ssd1306_pattern_solid, rop);
 }
 
-/* Fundamental */
-void set_contrast_control(uint8_t value)
+void ssd1306_draw_hline(uint8_t x, uint8_t y, uint8_t w)
 {
-    ssd1306_write_command(SET_CONTRAST_CONTROL);
-    ssd1306_write_command(value);
+    ssd1306_fill_box(x, y, w, 1, ssd1306_pattern_solid, raster_op);
 }
 
-void entire_display_off()
+void ssd1306_draw_vline_rop(uint8_t x, uint8_t y, uint8_t h, uint8_t rop)
 {
-    ssd1306_write_command(ENTIRE_DISPLAY_OFF);
+    ssd1306_fill_box(x, y, 1, h, ssd1306_pattern_solid, rop);
 }
 
-void entire_display_on()
+void ssd1306_draw_vline(uint8_t x, uint8_t y, uint8_t h)
 {
-    ssd1306_write_command(ENTIRE_DISPLAY_ON);
+    ssd1306_fill_box(x, y, 1, h, ssd1306_pattern_solid, raster_op);
 }
 
-void set_normal_display()
+void ssd1306_fill_rect_rop(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t* pattern, uint8_t rop)
 {
-    ssd1306_write_command(SET_NORMAL_DISPLAY);
+    ssd1306_fill_box(x, y, w, h, pattern != NULL ? pattern : ssd1306_pattern_solid, rop);
 }
 
-void set_inverse_display()
+void ssd1306_fill_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
 {
-    ssd1306_write_command(SET_INVERSE_DISPLAY);
+    ssd1306_fill_box(x, y, w, h, ssd1306_pattern_solid, raster_op);
 }
 
-void set_display_on()
+void ssd1306_draw_rect_rop(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t rop)
 {
-    ssd1306_write_command(SET_DISPLAY_ON);
+    if(w == 0 || h == 0)
+        return;
+
+    // Sides without the corner rows, XOR touches every pixel once
+    ssd1306_fill_box(x, y, w, 1, ssd1306_pattern_solid, rop);
+
+    // Far sides past coordinate 255 are off screen, not wrapped
+    if(h > 1 && y + h - 1 <= UINT8_MAX)
+        ssd1306_fill_box(x, y + h - 1, w, 1, ssd1306_pattern_solid, rop);
+
+    if(h > 2)
+    {
+        ssd1306_fill_box(x, y + 1, 1, h - 2, ssd1306_pattern_solid, rop);
+
+        if(w > 1 && x + w - 1 <= UINT8_MAX)
+            ssd1306_fill_box(x + w - 1, y + 1, 1, h - 2, ssd1306_pattern_solid, rop);
+    }
 }
 
-void set_display_off()
+void ssd1306_draw_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
 {
-    ssd1306_write_command(SET_DISPLAY_OFF);
+    ssd1306_draw_rect_rop(x, y, w, h, raster_op);
 }
 
 
-/* Scrolling Command */
-// 안써용~
+// Write full string to screen buffer
+char ssd1306_write_string_rop(SSD1306_FONT font, char *str, uint8_t rop)
+{
+    current_font = font;
 
+    // Write until null-byte
+    while(*str)
+    {
+        if(ssd1306_write_char_rop(font, *str, rop) != *str)
+        {
+            // Char could not be written
+            return *str;
+        }
 
-/* Addressing Setting */
-void set_lower_column_start_address_for_page_addressing_mode(uint8_t addr)
-{
-    ssd1306_write_command(addr);
+        // Next char
+        str++;
+    }
+
+    // Everything ok
+    return *str;
 }
 
-void set_higher_column_start_address_for_page_addressing_mode(uint8_t addr)
+char ssd1306_write_string(SSD1306_FONT font, char *str)
 {
-    ssd1306_write_command(addr);
+    return ssd1306_write_string_rop(font, str, raster_op);
 }
 
-void set_memory_addressing_mode(uint8_t mode)
+void ssd1306_set_rop(uint8_t rop)
 {
-    ssd1306_write_command(SET_MEMORY_ADDRESSING_MODE);
-    ssd1306_write_command(mode);
+    raster_op = rop;
 }
 
-void set_column_address(uint8_t start, uint8_t end)
+uint8_t ssd1306_get_rop()
 {
-    ssd1306_write_command(SET_COLUMN_ADDRESS);
-    ssd1306_write_command(start);
-    ssd1306_write_command(end);
+    return raster_op;
 }
 
-void set_page_address(uint8_t start, uint8_t end)
+/* Clip & Origin */
+static void ssd1306_clip_view()
 {
-    ssd1306_write_command(SET_PAGE_ADDRESS);
-    ssd1306_write_command(start);
-    ssd1306_write_command(end);
+    view = clip_stack[clip_depth];
+
+    // Streaming : rows of other pages are not in memory
+    if(view.y0 < band_page * 8)
+        view.y0 = band_page * 8;
+
+    if(view.y1 > (band_page + SSD1306_BUFFER_PAGES) * 8)
+        view.y1 = (band_page + SSD1306_BUFFER_PAGES) * 8;
+
+    if(view.y0 > view.y1)
+        view.y0 = view.y1;
 }
 
-void set_page_start_address_for_page_addressing_mode(uint8_t page)  // 0xB0(page0) ~ 0xB7(page7)
+HAL_StatusTypeDef ssd1306_push_clip(int16_t x, int16_t y, uint8_t w, uint8_t h)
 {
-    ssd1306_write_command(page);
+    const SSD1306_CLIP* top = &clip_stack[clip_depth];
+    SSD1306_CLIP* clip;
+    int16_t x0 = x + origin_x;
+    int16_t y0 = y + origin_y;
+    int16_t x1 = x0 + w;
+    int16_t y1 = y0 + h;
+
+    if(clip_depth + 1 >= SSD1306_CLIP_DEPTH)
+        return HAL_ERROR;
+
+    clip = &clip_stack[++clip_depth];
+
+    // Intersection with the clip below, empty stays empty
+    clip->x0 = x0 > top->x0 ? x0 : top->x0;
+    clip->y0 = y0 > top->y0 ? y0 : top->y0;
+    clip->x1 = x1 < top->x1 ? (x1 > clip->x0 ? x1 : clip->x0) : top->x1;
+    clip->y1 = y1 < top->y1 ? (y1 > clip->y0 ? y1 : clip->y0) : top->y1;
+
+    if(clip->x0 > clip->x1)
+        clip->x0 = clip->x1;
+
+    if(clip->y0 > clip->y1)
+        clip->y0 = clip->y1;
+
+    ssd1306_clip_view();
+
+    return HAL_OK;
 }
 
+HAL_StatusTypeDef ssd1306_push_panel_clip(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    SSD1306_CLIP* clip;
 
-/* Hardware Configuration */
-void set_display_start_line(uint8_t start_line)
+    if(clip_depth + 1 >= SSD1306_CLIP_DEPTH)
+        return HAL_ERROR;
+
+    clip = &clip_stack[++clip_depth];
+
+    // Cut to the panel only, the clips below do not apply
+    clip->x0 = x < SSD1306_WIDTH ? x : SSD1306_WIDTH;
+    clip->y0 = y < SSD1306_HEIGHT ? y : SSD1306_HEIGHT;
+    clip->x1 = x + w < SSD1306_WIDTH ? x + w : SSD1306_WIDTH;
+    clip->y1 = y + h < SSD1306_HEIGHT ? y + h : SSD1306_HEIGHT;
+
+    ssd1306_clip_view();
+
+    return HAL_OK;
+}
+
+void ssd1306_pop_clip()
 {
-    ssd1306_write_command(start_line);
+    if(clip_depth > 0)
+        clip_depth--;
+
+    ssd1306_clip_view();
 }
 
-void set_segment_remap(uint8_t mapping)
+void ssd1306_reset_clip()
 {
-    ssd1306_write_command(mapping);
+    clip_depth = 0;
+    origin_x = 0;
+    origin_y = 0;
+
+    ssd1306_clip_view();
 }
 
-void set_multiplex_ratio(uint8_t mux)
+void ssd1306_set_origin(int16_t x, int16_t y)
 {
-    ssd1306_write_command(SET_MULTIPLEX_RATIO);
-    ssd1306_write_command(mux);
+    origin_x = x;
+    origin_y = y;
 }
 
-void set_com_output_scan_direction(uint8_t mode)
+void ssd1306_get_origin(int16_t* x, int16_t* y)
 {
-    ssd1306_write_command(mode);
+    *x = origin_x;
+    *y = origin_y;
 }
 
-void set_display_offset(uint8_t vertical_shift)
+void ssd1306_set_cursor(uint8_t x, uint8_t y)
 {
-    ssd1306_write_command(SET_DISPLAY_OFFSET);
-    ssd1306_write_command(vertical_shift);
+    cursor.x = x;
+    cursor.y = y;
 }
 
-void set_com_pins_hardware_config(uint8_t com_pin_config, uint8_t com_left_right_remap)
+void ssd1306_enter()
 {
-    uint8_t buffer = 0x02 | (com_pin_config << 4) | (com_left_right_remap << 5);
+    cursor.x = 0;
+    cursor.y += current_font.height;
+}
 
-    ssd1306_write_command(SET_COM_PINS_HARDWARE_CONFIG);
-    ssd1306_write_command(buffer);
+void ssd1306_space()
+{
+    cursor.x += current_font.width;
 }
 
 
-/* Timing & Driving Scheme Setting */
-void set_display_clock_divide_ratio_and_osc_freq(uint8_t divide_ratio, uint8_t osc_freq)
+/* Buffer Operation */
+#if defined(SSD1306_USE_M2M_DMA)
+static DMA_HandleTypeDef ssd1306_hdma;
+static volatile uint32_t fill_word;
+static volatile uint8_t mem_busy;
+static uint8_t mem_flush;
+static volatile uint8_t flush_pending;
+
+// ISR only marks the flush, the I2C queue and blocking transfers are thread context
+static void ssd1306_mem_dma_cplt(DMA_HandleTypeDef *hdma)
 {
-    uint8_t buffer = (osc_freq << 4) | divide_ratio;
+    if(mem_flush)
+        flush_pending = 1;
 
-    ssd1306_write_command(SET_DISPLAY_CLOCK_DIVIDE_RATIO_AND_OSC_FREQ);
-    ssd1306_write_command(buffer);
+    mem_busy = 0;
 }
 
-void set_pre_charge_period(uint8_t phase_1, uint8_t phase_2)
+static void ssd1306_mem_flush_pending()
 {
-    uint8_t buffer = (phase_2 << 4) | phase_1;
-
-    ssd1306_write_command(SET_PRE_CHARGE_PERIOD);
-    ssd1306_write_command(buffer);
+    if(flush_pending)
+    {
+        flush_pending = 0;
+        ssd1306_update_screen_async();
+    }
 }
 
-void set_v_comh_deselect_level(uint8_t deselect_level)
+static void ssd1306_mem_dma_error(DMA_HandleTypeDef *hdma)
 {
-    ssd1306_write_command(SET_V_COMH_DESELECT_LEVEL);
-    ssd1306_write_command(deselect_level);
+    mem_busy = 0;
 }
 
+// Source is the peripheral port in memory-to-memory mode, fixed address for fill
+static HAL_StatusTypeDef ssd1306_mem_dma_init(uint32_t source_inc)
+{
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    ssd1306_hdma.Instance = SSD1306_M2M_DMA_STREAM;
+    ssd1306_hdma.Init.Channel = DMA_CHANNEL_0;
+    ssd1306_hdma.Init.Direction = DMA_MEMORY_TO_MEMORY;
+    ssd1306_hdma.Init.PeriphInc = source_inc;
+    ssd1306_hdma.Init.MemInc = DMA_MINC_ENABLE;
+    ssd1306_hdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    ssd1306_hdma.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    ssd1306_hdma.Init.Mode = DMA_NORMAL;
+    ssd1306_hdma.Init.Priority = DMA_PRIORITY_LOW;
+    ssd1306_hdma.Init.FIFOMode = DMA_FIFOMODE_ENABLE;    // direct mode is not allowed for memory-to-memory
+    ssd1306_hdma.Init.FIFOThreshold = DMA_FIFO_THRESHOLD_FULL;
+    ssd1306_hdma.Init.MemBurst = DMA_MBURST_SINGLE;       // 16-byte bursts of a word aligned buffer can cross a 1 KB boundary
+    ssd1306_hdma.Init.PeriphBurst = DMA_PBURST_SINGLE;
+
+    ssd1306_hdma.XferCpltCallback = ssd1306_mem_dma_cplt;
+    ssd1306_hdma.XferErrorCallback = ssd1306_mem_dma_error;
+
+    return HAL_DMA_Init(&ssd1306_hdma);
+}
 
-/* SSD1306 Function */
-void ssd1306_init()
+// Word-aligned body on DMA, unaligned head and tail bytes by CPU
+// @param : 0(blocking), 1(interrupt, optionally flush when done)
+static HAL_StatusTypeDef ssd1306_mem_dma(uint8_t* dst, const uint8_t* src, uint32_t pattern, uint16_t size, uint8_t async, uint8_t flush)
 {
-    // SSD1306 App Note 5p
-    set_multiplex_ratio(63);
+    HAL_StatusTypeDef status;
+    uint16_t words;
+
+    ssd1306_mem_wait();
+
+    // Head bytes until dst is aligned, src must end up aligned too
+    while(size && ((uintptr_t)dst & 3))
+    {
+        *dst = src ? *src++ : (uint8_t)(pattern >> (8 * ((uintptr_t)dst & 3)));
+        dst++;
+        size--;
+    }
 
-    set_display_offset(0);
+    words = size / 4;
 
-    set_display_start_line(0x40);
+    // Tail bytes
+    for(uint16_t i = words * 4; i < size; i++)
+        dst[i] = src ? src[i] : (uint8_t)(pattern >> (8 * (i & 3)));
 
-    set_segment_remap(0xA1);
+    if(words == 0 || (src && ((uintptr_t)src & 3)))
+    {
+        // Misaligned source, CPU copies the body as well
+        if(words)
+            memcpy(dst, src, words * 4);
 
-    set_com_output_scan_direction(0xC8);
+        if(flush)
+            ssd1306_update_screen_async();
 
-    set_com_pins_hardware_config(1, 0);
+        return HAL_OK;
+    }
 
-    set_contrast_control(0x7F);
+    if(src == NULL)
+        fill_word = pattern;
 
-    entire_display_off();
+    status = ssd1306_mem_dma_init(src ? DMA_PINC_ENABLE : DMA_PINC_DISABLE);
 
-    set_normal_display();
+    if(status != HAL_OK)
+        return status;
 
-    set_display_clock_divide_ratio_and_osc_freq(0, 8);
+    mem_flush = flush;
+    mem_busy = 1;
 
-    charge_bump_setting(0x14);
+    if(async)
+    {
+        status = HAL_DMA_Start_IT(&ssd1306_hdma, src ? (uint32_t)src : (uint32_t)&fill_word, (uint32_t)dst, words);
+    }
+    else
+    {
+        status = HAL_DMA_Start(&ssd1306_hdma, src ? (uint32_t)src : (uint32_t)&fill_word, (uint32_t)dst, words);
 
-    set_display_on();
+        if(status == HAL_OK)
+            status = HAL_DMA_PollForTransfer(&ssd1306_hdma, HAL_DMA_FULL_TRANSFER, SSD1306_I2C_TIMEOUT);
 
-    // Clear Ram Data
-    ssd1306_black_screen();
+        mem_busy = 0;
+    }
 
-    // Set cursor 0, 0
-    ssd1306_set_cursor(0, 0);
+    if(status != HAL_OK)
+        mem_busy = 0;
+
+    return status;
 }
+#endif
 
-void ssd1306_update_screen()
+#if !defined(SSD1306_USE_M2M_DMA)
+// Word-wide CPU fill, byte at address a gets pattern byte a % 4
+static SSD1306_RAM_FUNC void ssd1306_mem_fill_cpu(uint8_t* dst, uint32_t pattern, uint16_t size)
 {
-    for(int i = 0; i < SSD1306_PAGE; i ++)
-    {
-        set_page_start_address_for_page_addressing_mode(0xB0 + i);
-        set_lower_column_start_address_for_page_addressing_mode(0x00);
-        set_higher_column_start_address_for_page_addressing_mode(0x10);
+    uint32_t* word;
 
-        ssd1306_write_data(&ssd1306_buffer[SSD1306_WIDTH * i], SSD1306_WIDTH);
+    while(size && ((uintptr_t)dst & 3))
+    {
+        *dst = (uint8_t)(pattern >> (8 * ((uintptr_t)dst & 3)));
+        dst++;
+        size--;
     }
+
+    word = (uint32_t*)dst;
+
+    for(; size >= 4; size -= 4)
+        *word++ = pattern;
+
+    dst = (uint8_t*)word;
+
+    for(uint16_t i = 0; i < size; i++)
+        dst[i] = (uint8_t)(pattern >> (8 * i));
 }
 
-void ssd1306_black_screen()
+#if defined(SSD1306_USE_RAMFUNC)
+// newlib memcpy runs from flash, words when both sides share the alignment
+static SSD1306_RAM_FUNC void ssd1306_mem_copy_cpu(uint8_t* dst, const uint8_t* src, uint16_t size)
 {
-    for(int i = 0; i < SSD1306_BUFFER_SIZE; i++)
+    if((((uintptr_t)dst ^ (uintptr_t)src) & 3) == 0)
     {
-        ssd1306_buffer[i] = 0x00;
+        while(size && ((uintptr_t)dst & 3))
+        {
+            *dst++ = *src++;
+            size--;
+        }
+
+        for(; size >= 4; size -= 4, dst += 4, src += 4)
+            *(uint32_t*)dst = *(const uint32_t*)src;
     }
 
-    ssd1306_update_screen();
+    while(size--)
+        *dst++ = *src++;
 }
+#endif
+#endif
 
-void ssd1306_white_screen()
+// Lit pixels of the part of dst inside the frame buffer, 0 when the count is stale anyway
+static SSD1306_RAM_FUNC uint16_t ssd1306_mem_lit(const uint8_t* dst, uint16_t size)
+{
+    const uint8_t* start = dst > ssd1306_buffer ? dst : ssd1306_buffer;
+    const uint8_t* end = dst + size < ssd1306_buffer + SSD1306_BUFFER_SIZE ? dst + size : ssd1306_buffer + SSD1306_BUFFER_SIZE;
+    uint16_t count = 0;
+
+    if(lit_stale)
+        return 0;
+
+    for(; start < end && ((uintptr_t)start & 3); start++)
+        count += ssd1306_popcount32(*start);
+
+    for(; start + 4 <= end; start += 4)
+        count += ssd1306_popcount32(*(const uint32_t*)start);
+
+    for(; start < end; start++)
+        count += ssd1306_popcount32(*start);
+
+    return count;
+}
+
+// Bulk write done, lit count moves by the difference over the written range only
+static SSD1306_RAM_FUNC void ssd1306_mem_written(const uint8_t* dst, uint16_t size, uint16_t lit_before)
+{
+    if(!lit_stale)
+        lit_pixels = lit_pixels - lit_before + ssd1306_mem_lit(dst, size);
+}
+
+// Written without the count, e.g. DMA after return or word kernels, recount on next read
+SSD1306_RAM_FUNC void ssd1306_mem_touch(const void* dst, uint16_t size)
+{
+    const uint8_t* start = dst;
+
+    if(start < ssd1306_buffer + SSD1306_BUFFER_SIZE && start + size > ssd1306_buffer)
+        lit_stale = 1;
+}
+
+uint8_t* ssd1306_get_buffer()
+{
+    return ssd1306_buffer;
+}
+
+uint8_t* ssd1306_get_page(uint8_t page)
+{
+    page -= band_page;
+
+    if(page >= SSD1306_BUFFER_PAGES)
+        return NULL;
+
+    return &ssd1306_buffer[SSD1306_WIDTH * page];
+}
+
+HAL_StatusTypeDef ssd1306_attach_frame(uint8_t* frame)
 {
-    for(int i = 0; i < SSD1306_BUFFER_SIZE; i++)
+    if(frame == NULL)
     {
-        ssd1306_buffer[i] = 0xFF;
+#if defined(SSD1306_USE_EXTERNAL_BUFFER)
+        return HAL_ERROR;
+#else
+        frame = ssd1306_frame;
+#endif
     }
 
-    ssd1306_update_screen();
+    // Word kernels and DMA need aligned frame
+    if((uintptr_t)frame & 3)
+        return HAL_ERROR;
+
+#if defined(SSD1306_BITBAND_ALIAS)
+    // Pixel functions write through the alias of this region only
+    if((uintptr_t)frame < SSD1306_BITBAND_SRAM || (uintptr_t)frame + SSD1306_FRAME_SIZE > SSD1306_BITBAND_SRAM + SSD1306_BITBAND_SIZE)
+        return HAL_ERROR;
+#endif
+
+    ssd1306_buffer = &frame[SSD1306_BUFFER_OFFSET];
+
+    // Panel still shows the old frame, dirty checksums stay valid so the next dirty flush sends the difference
+    lit_stale = 1;
+
+    return HAL_OK;
 }
 
-void ssd1306_black_pixel(uint8_t x, uint8_t y)
+SSD1306_RAM_FUNC HAL_StatusTypeDef ssd1306_mem_fill(void* dst, uint32_t pattern, uint16_t size)
 {
-    // (y / 8) * SSD1306_WIDTH : page
-    // y % 8 : data bit D0 - D7
-    ssd1306_buffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8));
+    HAL_StatusTypeDef status = HAL_OK;
+    uint16_t lit_before = ssd1306_mem_lit(dst, size);
+
+#if defined(SSD1306_USE_M2M_DMA)
+    status = ssd1306_mem_dma(dst, NULL, pattern, size, 0, 0);
+#else
+    ssd1306_mem_fill_cpu(dst, pattern, size);
+#endif
+
+    ssd1306_mem_written(dst, size, lit_before);
+
+    return status;
 }
 
-void ssd1306_white_pixel(uint8_t x, uint8_t y)
+SSD1306_RAM_FUNC HAL_StatusTypeDef ssd1306_mem_copy(void* dst, const void* src, uint16_t size)
 {
-    // (y / 8) * SSD1306_WIDTH : page
-    // y % 8 : data bit D0 - D7
-    ssd1306_buffer[x + (y / 8) * SSD1306_WIDTH] |= 1 << (y % 8);
+    HAL_StatusTypeDef status = HAL_OK;
+    uint16_t lit_before = ssd1306_mem_lit(dst, size);
+
+#if defined(SSD1306_USE_M2M_DMA)
+    status = ssd1306_mem_dma(dst, src, 0, size, 0, 0);
+#elif defined(SSD1306_USE_RAMFUNC)
+    ssd1306_mem_copy_cpu(dst, src, size);
+#else
+    // newlib memcpy moves words when both sides are aligned
+    memcpy(dst, src, size);
+#endif
+
+    ssd1306_mem_written(dst, size, lit_before);
+
+    return status;
 }
 
-char ssd1306_write_char(SSD1306_FONT font, char ch)
+HAL_StatusTypeDef ssd1306_mem_fill_async(void* dst, uint32_t pattern, uint16_t size, uint8_t flush)
 {
-    uint32_t b;
+#if defined(SSD1306_USE_M2M_DMA)
+    ssd1306_mem_touch(dst, size);
 
-    // Printable Characters : 32 - 126
-    if(ch < 32 || ch > 126)
-        return 0;
+    return ssd1306_mem_dma(dst, NULL, pattern, size, 1, flush);
+#else
+    uint16_t lit_before = ssd1306_mem_lit(dst, size);
+
+    ssd1306_mem_fill_cpu(dst, pattern, size);
+    ssd1306_mem_written(dst, size, lit_before);
+
+    return flush ? ssd1306_update_screen_async() : HAL_OK;
+#endif
+}
+
+HAL_StatusTypeDef ssd1306_mem_copy_async(void* dst, const void* src, uint16_t size, uint8_t flush)
+{
+#if defined(SSD1306_USE_M2M_DMA)
+    ssd1306_mem_touch(dst, size);
+
+    return ssd1306_mem_dma(dst, src, 0, size, 1, flush);
+#else
+    uint16_t lit_before = ssd1306_mem_lit(dst, size);
+
+#if defined(SSD1306_USE_RAMFUNC)
+    ssd1306_mem_copy_cpu(dst, src, size);
+#else
+    memcpy(dst, src, size);
+#endif
+    ssd1306_mem_written(dst, size, lit_before);
+
+    return flush ? ssd1306_update_screen_async() : HAL_OK;
+#endif
+}
+
+uint8_t ssd1306_mem_is_busy()
+{
+#if defined(SSD1306_USE_M2M_DMA)
+    ssd1306_mem_flush_pending();
+
+    return mem_busy;
+#else
+    return 0;
+#endif
+}
+
+void ssd1306_mem_wait()
+{
+#if defined(SSD1306_USE_M2M_DMA)
+    while(mem_busy);
+
+    ssd1306_mem_flush_pending();
+#endif
+}
+
+void ssd1306_m2m_dma_irq_handler()
+{
+#if defined(SSD1306_USE_M2M_DMA)
+    HAL_DMA_IRQHandler(&ssd1306_hdma);
+#endif
+}
+
+
+/* Lit Pixel Accounting */
+SSD1306_RAM_FUNC uint32_t ssd1306_popcount32(uint32_t word)
+{
+    // SWAR bit count, M4 has no popcount instruction
+    word = word - ((word >> 1) & 0x55555555);
+    word = (word & 0x33333333) + ((word >> 2) & 0x33333333);
+    word = (word + (word >> 4)) & 0x0F0F0F0F;
+
+    return (word * 0x01010101) >> 24;
+}
+
+SSD1306_RAM_FUNC uint16_t ssd1306_count_lit_pixels()
+{
+    const uint32_t* word = (const uint32_t*)ssd1306_buffer;
+    uint32_t count = 0;
+
+    for(int i = 0; i < SSD1306_BUFFER_SIZE / 4; i++)
+        count += ssd1306_popcount32(word[i]);
+
+    lit_pixels = count;
+    lit_stale = 0;
+
+    return count;
+}
+
+uint16_t ssd1306_get_lit_pixels()
+{
+    if(lit_stale)
+        ssd1306_count_lit_pixels();
+
+    return lit_pixels;
+}
+
+uint32_t ssd1306_get_panel_current()
+{
+    uint32_t pixel_current;
+    uint32_t lit;
+
+    if(state.display == SET_DISPLAY_OFF)
+        return SSD1306_CURRENT_SLEEP_UA;
 
-    // Check remaining space on current line
-    if (SSD1306_WIDTH < (cursor.x + font.width) ||  SSD1306_HEIGHT < (cursor.y + font.height))
+    // Pixels lit on the panel : entire display on lights all, inverse display the unset ones
+    if(state.entire_display == ENTIRE_DISPLAY_ON)
+        lit = SSD1306_WIDTH * SSD1306_HEIGHT;
+    else if(state.inverse == SET_INVERSE_DISPLAY)
+        lit = SSD1306_WIDTH * SSD1306_HEIGHT - ssd1306_get_lit_pixels();
+    else
+        lit = ssd1306_get_lit_pixels();
+
+    // Segment current scales with lit pixels and contrast
+    pixel_current = (uint32_t)SSD1306_CURRENT_FULL_UA * lit / (SSD1306_WIDTH * SSD1306_HEIGHT);
+    pixel_current = pixel_current * (state.contrast + 1) / 256;
+
+    return SSD1306_CURRENT_IDLE_UA + pixel_current;
+}
+
+// Called from ssd1306_power_task(), hysteresis of SSD1306_LIT_HYSTERESIS percent
+static void ssd1306_lit_policy()
+{
+    uint32_t percent = (uint32_t)ssd1306_get_lit_pixels() * 100 / (SSD1306_WIDTH * SSD1306_HEIGHT);
+
+    if(SSD1306_LIT_POLICY == SSD1306_LIT_POLICY_NONE || power_state == SSD1306_POWER_OFF)
+        return;
+
+    if(!lit_heavy && percent > SSD1306_LIT_THRESHOLD)
     {
-        // Not enough space on current line
-        return 0;
+        lit_heavy = 1;
+
+#if SSD1306_LIT_POLICY == SSD1306_LIT_POLICY_INVERSE
+        // Mostly lit content shows as mostly dark
+        set_inverse_display();
+#else
+        if(state.contrast > SSD1306_LIT_CONTRAST)
+            set_contrast_control(SSD1306_LIT_CONTRAST);
+#endif
     }
-
-    // Use the font to write
-    for(int i = 0; i < font.height; i++)
+    else if(lit_heavy && percent + SSD1306_LIT_HYSTERESIS < SSD1306_LIT_THRESHOLD)
     {
-        b = font.data[(ch - 32) * font.height + i];
-        
-        for(int j = 0; j < font.width; j++)
-        {
-            if((b << j) & 0x8000)
-            {
-                ssd1306_white_pixel(cursor.x + j, cursor.y + i);
-            }
-            else
-            {
-                ssd1306_black_pixel(cursor.x + j, cursor.y + i);
-            }
-        }
+        lit_heavy = 0;
+
+#if SSD1306_LIT_POLICY == SSD1306_LIT_POLICY_INVERSE
+        set_normal_display();
+#else
+        if(power_state == SSD1306_POWER_ACTIVE)
+            set_contrast_control(active_contrast);
+#endif
     }
+}
 
-    // The current space is now taken
-    cursor.x += font.width;
 
-    // Return written char for validation
-    return ch;
+/* Power Management */
+void ssd1306_power_activity()
+{
+    activity_tick = HAL_GetTick();
+
+    if(power_state == SSD1306_POWER_ACTIVE)
+        return;
+
+    // GDDRAM is retained in sleep, no flush needed
+    if(power_state == SSD1306_POWER_OFF)
+        set_display_on();
+
+    power_state = SSD1306_POWER_ACTIVE;
+
+    // Lit policy keeps the contrast down while the screen is mostly lit
+    if(lit_heavy && SSD1306_LIT_POLICY == SSD1306_LIT_POLICY_DIM && active_contrast > SSD1306_LIT_CONTRAST)
+        set_contrast_control(SSD1306_LIT_CONTRAST);
+    else
+        set_contrast_control(active_contrast);
 }
 
+// Orbit (0, 0) -> (1, 0) -> (1, 1) -> (0, 1), scaled by SSD1306_SHIFT_MAX
+static void ssd1306_power_shift()
+{
+    static const uint8_t orbit_x[] = {0, 1, 1, 0};
+    static const uint8_t orbit_y[] = {0, 0, 1, 1};
+    uint8_t x, y;
 
-// Write full string to screen buffer
-char ssd1306_write_string(SSD1306_FONT font, char *str)
+    shift_step = (shift_step + 1) % sizeof(orbit_x);
+
+    x = orbit_x[shift_step] * SSD1306_SHIFT_MAX;
+    y = orbit_y[shift_step] * SSD1306_SHIFT_MAX;
+
+    // Vertical : display offset register only
+    if(y != state.display_offset)
+        set_display_offset(y);
+
+    // Horizontal : frame window moves, buffer is re-sent as is
+    if(x != shift_x)
+    {
+        // Windows may still be in flight
+        ssd1306_wait_idle();
+
+        shift_x = x;
+
+        shift_window[0] = SET_COLUMN_ADDRESS;
+        shift_window[1] = x;
+        shift_window[2] = SSD1306_WIDTH - 1;
+        shift_window[3] = SET_PAGE_ADDRESS;
+        shift_window[4] = 0;
+        shift_window[5] = SSD1306_PAGE - 1;
+
+        shift_blank_window[0] = SET_COLUMN_ADDRESS;
+        shift_blank_window[1] = 0;
+        shift_blank_window[2] = x - 1;
+        shift_blank_window[3] = SET_PAGE_ADDRESS;
+        shift_blank_window[4] = 0;
+        shift_blank_window[5] = SSD1306_PAGE - 1;
+
+        // Streaming : next ssd1306_stream_frame() sends the shifted frame
+        if(shown_columns != NULL)
+            ssd1306_update_screen_vertical(shown_columns);
+#if !defined(SSD1306_USE_PAGE_STREAMING)
+        else
+            ssd1306_update_screen();
+#endif
+    }
+}
+
+void ssd1306_power_task()
 {
-    current_font = font;
+    uint32_t now = HAL_GetTick();
+    uint32_t idle = now - activity_tick;
 
-    // Write until null-byte
-    while(*str)
+#if defined(SSD1306_USE_M2M_DMA)
+    ssd1306_mem_flush_pending();
+#endif
+
+    // User contrast, lit policy may have lowered the register
+    if(power_state == SSD1306_POWER_ACTIVE && !lit_heavy)
+        active_contrast = state.contrast;
+
+    if(SSD1306_OFF_TIMEOUT && power_state != SSD1306_POWER_OFF && idle >= SSD1306_OFF_TIMEOUT)
     {
-        if(ssd1306_write_char(font, *str) != *str)
-        {
-            // Char could not be written
-            return *str;
-        }
+        set_display_off();
 
-        // Next char
-        str++;
+        power_state = SSD1306_POWER_OFF;
     }
+    else if(SSD1306_DIM_TIMEOUT && power_state == SSD1306_POWER_ACTIVE && idle >= SSD1306_DIM_TIMEOUT)
+    {
+        set_contrast_control(SSD1306_DIM_CONTRAST);
 
-    // Everything ok
-    return *str;
+        power_state = SSD1306_POWER_DIM;
+    }
+
+    ssd1306_lit_policy();
+
+    // Nothing burns in while the panel is off
+    if(SSD1306_SHIFT_PERIOD && power_state != SSD1306_POWER_OFF && now - shift_tick >= SSD1306_SHIFT_PERIOD)
+    {
+        shift_tick = now;
+
+        ssd1306_power_shift();
+    }
 }
 
-void ssd1306_set_cursor(uint8_t x, uint8_t y)
+uint8_t ssd1306_get_power_state()
 {
-    cursor.x = x;
-    cursor.y = y;
+    return power_state;
 }
 
-void ssd1306_enter()
+
+/* Statistics */
+__weak uint32_t ssd1306_get_timestamp()
 {
-    cursor.x = 0;
-    cursor.y += current_font.height;
+#if defined(DWT)
+    return DWT->CYCCNT;
+#else
+    return HAL_GetTick();
+#endif
 }
 
-void ssd1306_space()
+const SSD1306_STATS* ssd1306_get_stats()
 {
-    cursor.x += current_font.width;
+    return &stats;
 }
\ No newline at end of file
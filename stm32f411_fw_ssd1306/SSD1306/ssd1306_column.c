@@ -0,0 +1,165 @@
+/*
+ * ssd1306_column.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#include "ssd1306_column.h"
+#include <string.h> // memset, memmove
+
+
+/* SSD1306 Column-Major Canvas Variable */
+
+static uint64_t column_buffer[SSD1306_WIDTH];
+
+
+/* Column-Major Canvas Function */
+uint64_t* ssd1306_column_get_buffer()
+{
+    return column_buffer;
+}
+
+void ssd1306_column_clear()
+{
+    memset(column_buffer, 0x00, sizeof(column_buffer));
+}
+
+SSD1306_RAM_FUNC void ssd1306_column_black_pixel(uint8_t x, uint8_t y)
+{
+    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+        return;
+
+    column_buffer[x] &= ~(1ULL << y);
+}
+
+SSD1306_RAM_FUNC void ssd1306_column_white_pixel(uint8_t x, uint8_t y)
+{
+    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+        return;
+
+    column_buffer[x] |= 1ULL << y;
+}
+
+SSD1306_RAM_FUNC void ssd1306_column_vline(uint8_t x, uint8_t y0, uint8_t y1, uint8_t color)
+{
+    uint64_t mask;
+
+    if(y0 > y1)
+    {
+        uint8_t y = y0;
+
+        y0 = y1;
+        y1 = y;
+    }
+
+    if(x >= SSD1306_WIDTH || y0 >= SSD1306_HEIGHT)
+        return;
+
+    if(y1 >= SSD1306_HEIGHT)
+        y1 = SSD1306_HEIGHT - 1;
+
+    // Bits y0 - y1, shift by 64 is undefined so the top is cut from all ones
+    mask = (~0ULL >> (SSD1306_HEIGHT - 1 - y1)) & (~0ULL << y0);
+
+    if(color == SSD1306_WHITE)
+        column_buffer[x] |= mask;
+    else
+        column_buffer[x] &= ~mask;
+}
+
+SSD1306_RAM_FUNC void ssd1306_column_bar(uint8_t x, uint8_t w, uint8_t h)
+{
+    // Bits 64 - h to 63, shift by 64 is undefined so empty and full bars are special
+    uint64_t bar = h == 0 ? 0 : (h >= SSD1306_HEIGHT ? ~0ULL : ~0ULL << (SSD1306_HEIGHT - h));
+
+    for(uint8_t i = 0; i < w && x < SSD1306_WIDTH; i++, x++)
+        column_buffer[x] = bar;
+}
+
+SSD1306_RAM_FUNC char ssd1306_column_write_char(uint8_t x, uint8_t y, SSD1306_FONT font, char ch)
+{
+    const uint16_t* glyph;
+    uint64_t cover;
+
+    // Printable Characters : 32 - 126
+    if(ch < 32 || ch > 126)
+        return 0;
+
+    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+        return 0;
+
+    glyph = &font.data[(ch - 32) * font.height];
+
+    // Rows pushed past bit 63 drop out of the shift
+    cover = ((1ULL << font.height) - 1) << y;
+
+    for(uint8_t j = 0; j < font.width && x + j < SSD1306_WIDTH; j++)
+    {
+        uint64_t bits = 0;
+
+        for(uint8_t i = 0; i < font.height; i++)
+        {
+            if((glyph[i] << j) & 0x8000)
+                bits |= 1ULL << i;
+        }
+
+        column_buffer[x + j] = (column_buffer[x + j] & ~cover) | (bits << y);
+    }
+
+    return ch;
+}
+
+char ssd1306_column_write_string(uint8_t x, uint8_t y, SSD1306_FONT font, char* str)
+{
+    // Write until null-byte
+    while(*str)
+    {
+        if(ssd1306_column_write_char(x, y, font, *str) != *str)
+        {
+            // Char could not be written
+            return *str;
+        }
+
+        // Next char
+        x += font.width;
+        str++;
+    }
+
+    // Everything ok
+    return *str;
+}
+
+SSD1306_RAM_FUNC void ssd1306_column_scroll(int8_t dx)
+{
+    uint8_t n = dx < 0 ? -dx : dx;
+
+    if(n >= SSD1306_WIDTH)
+    {
+        ssd1306_column_clear();
+        return;
+    }
+
+    // Whole columns move, one uint64_t each
+    if(dx < 0)
+    {
+        memmove(column_buffer, &column_buffer[n], (SSD1306_WIDTH - n) * sizeof(uint64_t));
+        memset(&column_buffer[SSD1306_WIDTH - n], 0x00, n * sizeof(uint64_t));
+    }
+    else
+    {
+        memmove(&column_buffer[n], column_buffer, (SSD1306_WIDTH - n) * sizeof(uint64_t));
+        memset(column_buffer, 0x00, n * sizeof(uint64_t));
+    }
+}
+
+HAL_StatusTypeDef ssd1306_column_update_screen()
+{
+    return ssd1306_update_screen_vertical((const uint8_t*)column_buffer);
+}
+
+HAL_StatusTypeDef ssd1306_column_update_screen_async()
+{
+    return ssd1306_update_screen_vertical_async((const uint8_t*)column_buffer);
+}
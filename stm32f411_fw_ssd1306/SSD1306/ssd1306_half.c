@@ -0,0 +1,87 @@
+/*
+ * ssd1306_half.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#include "ssd1306_half.h"
+#include <string.h> // memset
+
+
+/* SSD1306 Half Resolution Variable */
+
+static uint8_t half_buffer[SSD1306_HALF_BUFFER_SIZE] __attribute__((aligned(4)));
+
+// Nibble to byte, every bit doubled : 0b0101 -> 0b00110011
+static const uint8_t half_double[16] =
+{
+    0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+    0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+
+
+/* Half Resolution Function */
+uint8_t* ssd1306_half_get_buffer()
+{
+    return half_buffer;
+}
+
+void ssd1306_half_clear()
+{
+    memset(half_buffer, 0x00, sizeof(half_buffer));
+}
+
+void ssd1306_half_black_pixel(uint8_t x, uint8_t y)
+{
+    if(x >= SSD1306_HALF_WIDTH || y >= SSD1306_HALF_HEIGHT)
+        return;
+
+    half_buffer[x + (y / 8) * SSD1306_HALF_WIDTH] &= ~(1 << (y % 8));
+}
+
+void ssd1306_half_white_pixel(uint8_t x, uint8_t y)
+{
+    if(x >= SSD1306_HALF_WIDTH || y >= SSD1306_HALF_HEIGHT)
+        return;
+
+    half_buffer[x + (y / 8) * SSD1306_HALF_WIDTH] |= 1 << (y % 8);
+}
+
+void ssd1306_half_draw(void* context)
+{
+    uint16_t row[SSD1306_HALF_WIDTH] __attribute__((aligned(4)));
+
+    (void)context;
+
+    for(uint8_t page = 0; page < SSD1306_PAGE; page++)
+    {
+        uint8_t* dst = ssd1306_get_page(page);
+
+        // Canvas page holds two panel pages, low nibble on top
+        const uint8_t* src = &half_buffer[SSD1306_HALF_WIDTH * (page / 2)];
+        uint8_t shift = (page % 2) * 4;
+
+        if(dst == NULL)
+            continue;
+
+        // Both columns of a pair get the same byte, one halfword store
+        for(uint8_t x = 0; x < SSD1306_HALF_WIDTH; x++)
+            row[x] = half_double[(src[x] >> shift) & 0x0F] * 0x0101;
+
+        // Lit pixel count follows the copy
+        ssd1306_mem_copy(dst, row, SSD1306_WIDTH);
+    }
+}
+
+HAL_StatusTypeDef ssd1306_half_update_screen()
+{
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    return ssd1306_stream_frame(ssd1306_half_draw, NULL);
+#else
+    ssd1306_half_draw(NULL);
+
+    return ssd1306_update_screen_dirty();
+#endif
+}
@@ -0,0 +1,47 @@
+/*
+ * ssd1306_half.h
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#ifndef __SSD1306_HALF_H__
+#define __SSD1306_HALF_H__
+
+
+#include "ssd1306.h"
+
+
+/* SSD1306 Half Resolution Constant */
+
+// Every canvas pixel is 2x2 panel pixels
+#define SSD1306_HALF_WIDTH          (SSD1306_WIDTH / 2)
+#define SSD1306_HALF_HEIGHT         (SSD1306_HEIGHT / 2)
+#define SSD1306_HALF_PAGE           (SSD1306_PAGE / 2)
+
+#define SSD1306_HALF_BUFFER_SIZE    (SSD1306_HALF_WIDTH * SSD1306_HALF_PAGE)
+
+
+/* SSD1306 Half Resolution Function */
+
+// Canvas, SSD1306_HALF_BUFFER_SIZE bytes, page-major like the frame buffer
+uint8_t* ssd1306_half_get_buffer();
+
+void ssd1306_half_clear();
+
+// @param : 0 - 63
+// @param : 0 - 31
+void ssd1306_half_black_pixel(uint8_t x, uint8_t y);
+void ssd1306_half_white_pixel(uint8_t x, uint8_t y);
+
+// Upscale into the frame buffer, pages not held in memory are skipped
+// Usable as ssd1306_stream_frame() callback
+void ssd1306_half_draw(void* context);
+
+// Upscale and send the tiles that changed with ssd1306_update_screen_dirty()
+// Streaming : ssd1306_stream_frame(ssd1306_half_draw, NULL)
+HAL_StatusTypeDef ssd1306_half_update_screen();
+
+
+#endif /* __SSD1306_HALF_H__ */
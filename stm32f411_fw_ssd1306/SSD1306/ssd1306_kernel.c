@@ -0,0 +1,274 @@
+/*
+ * ssd1306_kernel.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#include "ssd1306_kernel.h"
+#include "ssd1306_column.h"
+#include <string.h> // memmove
+
+
+/* Byte Lanes */
+// Non-zero byte lanes of x become 0xFF, zero lanes stay 0x00
+static inline uint32_t ssd1306_kernel_nonzero(uint32_t x)
+{
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    // x + 0xFF carries out of every non-zero lane and sets its GE flag, SEL picks by GE
+    // One asm block : the compiler may not schedule flag setting code between the two
+    uint32_t lanes;
+
+    __asm volatile ("uadd8 %0, %1, %2\n\t"
+                    "sel %0, %2, %3"
+                    : "=&r" (lanes)
+                    : "r" (x), "r" (0xFFFFFFFF), "r" (0x00000000)
+                    : "cc");
+
+    return lanes;
+#else
+    // High bit of each lane : low 7 bits carry into it, or it was set already
+    uint32_t high = (((x & 0x7F7F7F7F) + 0x7F7F7F7F) | x) & 0x80808080;
+
+    return (high >> 7) * 0xFF;
+#endif
+}
+
+
+/* Kernel Function */
+SSD1306_RAM_FUNC void ssd1306_kernel_fill(uint32_t* dst, uint32_t pattern, uint16_t words)
+{
+    for(uint16_t i = 0; i < words; i++)
+        dst[i] = pattern;
+
+    ssd1306_mem_touch(dst, words * 4);
+}
+
+SSD1306_RAM_FUNC void ssd1306_kernel_invert(uint32_t* dst, uint16_t words)
+{
+    for(uint16_t i = 0; i < words; i++)
+        dst[i] = ~dst[i];
+
+    ssd1306_mem_touch(dst, words * 4);
+}
+
+SSD1306_RAM_FUNC void ssd1306_kernel_blend(uint32_t* dst, const uint32_t* src, const uint32_t* mask, uint16_t words)
+{
+    // (dst & ~mask) | (src & mask) in three operations
+    for(uint16_t i = 0; i < words; i++)
+        dst[i] ^= (dst[i] ^ src[i]) & mask[i];
+
+    ssd1306_mem_touch(dst, words * 4);
+}
+
+SSD1306_RAM_FUNC void ssd1306_kernel_or(uint32_t* dst, const uint32_t* src, uint16_t words)
+{
+    for(uint16_t i = 0; i < words; i++)
+        dst[i] |= src[i];
+
+    ssd1306_mem_touch(dst, words * 4);
+}
+
+SSD1306_RAM_FUNC void ssd1306_kernel_and(uint32_t* dst, const uint32_t* src, uint16_t words)
+{
+    for(uint16_t i = 0; i < words; i++)
+        dst[i] &= src[i];
+
+    ssd1306_mem_touch(dst, words * 4);
+}
+
+SSD1306_RAM_FUNC void ssd1306_kernel_xor(uint32_t* dst, const uint32_t* src, uint16_t words)
+{
+    for(uint16_t i = 0; i < words; i++)
+        dst[i] ^= src[i];
+
+    ssd1306_mem_touch(dst, words * 4);
+}
+
+SSD1306_RAM_FUNC void ssd1306_kernel_shift(uint32_t* dst, const uint32_t* page, const uint32_t* next, uint8_t bits, uint16_t words)
+{
+    // Shifting whole words, masks drop the bits that crossed into the neighbour lane
+    uint32_t low = 0x01010101 * (0xFF >> bits);
+
+    for(uint16_t i = 0; i < words; i++)
+    {
+        uint32_t below = next != NULL ? next[i] : 0;
+
+        dst[i] = ((page[i] >> bits) & low) | ((below << (8 - bits)) & ~low);
+    }
+
+    ssd1306_mem_touch(dst, words * 4);
+}
+
+SSD1306_RAM_FUNC uint16_t ssd1306_kernel_compare(const uint32_t* a, const uint32_t* b, uint16_t words, uint16_t* first, uint16_t* last)
+{
+    uint16_t count = 0;
+
+    for(uint16_t i = 0; i < words; i++)
+    {
+        uint32_t lanes;
+
+        if(a[i] == b[i])
+            continue;
+
+        lanes = ssd1306_kernel_nonzero(a[i] ^ b[i]);
+
+        // Little-endian, lowest lane is the lowest address
+        if(first != NULL && count == 0)
+            *first = i * 4 + __builtin_ctz(lanes) / 8;
+
+        if(last != NULL)
+            *last = i * 4 + 3 - __builtin_clz(lanes) / 8;
+
+        count += ssd1306_popcount32(lanes) / 8;
+    }
+
+    return count;
+}
+
+void ssd1306_kernel_benchmark(uint32_t* cycles)
+{
+    uint32_t* frame = (uint32_t*)ssd1306_get_buffer();
+    uint16_t words = SSD1306_BUFFER_SIZE / 4;
+    uint16_t half = words / 2;
+    uint32_t start;
+
+    // Second half of the frame is the source, blend mask and compare partner
+    start = ssd1306_get_timestamp();
+    ssd1306_kernel_fill(frame, 0x5A5A5A5A, words);
+    cycles[SSD1306_KERNEL_FILL] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+    ssd1306_kernel_invert(frame, words);
+    cycles[SSD1306_KERNEL_INVERT] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+    ssd1306_kernel_blend(frame, &frame[half], &frame[half], half);
+    cycles[SSD1306_KERNEL_BLEND] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+    ssd1306_kernel_or(frame, &frame[half], half);
+    cycles[SSD1306_KERNEL_OR] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+    ssd1306_kernel_and(frame, &frame[half], half);
+    cycles[SSD1306_KERNEL_AND] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+    ssd1306_kernel_xor(frame, &frame[half], half);
+    cycles[SSD1306_KERNEL_XOR] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+    ssd1306_kernel_shift(frame, frame, &frame[half], 3, half);
+    cycles[SSD1306_KERNEL_SHIFT] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+    ssd1306_kernel_compare(frame, &frame[half], half, NULL, NULL);
+    cycles[SSD1306_KERNEL_COMPARE] = ssd1306_get_timestamp() - start;
+
+    // Pixel throughput, lit count must be right before the pixel functions keep it
+    ssd1306_kernel_fill(frame, 0x00000000, words);
+    ssd1306_count_lit_pixels();
+
+    start = ssd1306_get_timestamp();
+
+    for(uint8_t y = 0; y < SSD1306_HEIGHT; y++)
+    {
+        for(uint8_t x = 0; x < SSD1306_WIDTH; x++)
+        {
+            ssd1306_white_pixel(x, y);
+            ssd1306_black_pixel(x, y);
+        }
+    }
+
+    cycles[SSD1306_KERNEL_PIXEL] = ssd1306_get_timestamp() - start;
+
+    // Line primitives against the per-pixel path, same pixels touched
+    start = ssd1306_get_timestamp();
+
+    for(uint8_t y = 0; y < SSD1306_HEIGHT; y++)
+        ssd1306_draw_hline_rop(0, y, SSD1306_WIDTH, SSD1306_ROP_XOR);
+
+    for(uint8_t x = 0; x < SSD1306_WIDTH; x++)
+        ssd1306_draw_vline_rop(x, 0, SSD1306_HEIGHT, SSD1306_ROP_XOR);
+
+    cycles[SSD1306_KERNEL_SPAN] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+
+    for(uint8_t y = 0; y < SSD1306_HEIGHT; y++)
+        for(uint8_t x = 0; x < SSD1306_WIDTH; x++)
+            ssd1306_draw_pixel_rop(x, y, SSD1306_ROP_XOR);
+
+    for(uint8_t x = 0; x < SSD1306_WIDTH; x++)
+        for(uint8_t y = 0; y < SSD1306_HEIGHT; y++)
+            ssd1306_draw_pixel_rop(x, y, SSD1306_ROP_XOR);
+
+    cycles[SSD1306_KERNEL_SPAN_PIXEL] = ssd1306_get_timestamp() - start;
+
+    // Chart workloads, column-major canvas against the page-major buffer, same bar heights
+    start = ssd1306_get_timestamp();
+
+    for(uint8_t x = 0; x < SSD1306_WIDTH; x++)
+        ssd1306_column_bar(x, 1, x * 37 % (SSD1306_HEIGHT + 1));
+
+    cycles[SSD1306_KERNEL_COLUMN_BAR] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+
+    for(uint8_t x = 0; x < SSD1306_WIDTH; x++)
+    {
+        uint8_t h = x * 37 % (SSD1306_HEIGHT + 1);
+
+        ssd1306_draw_vline_rop(x, 0, SSD1306_HEIGHT - h, SSD1306_ROP_CLEAR);
+        ssd1306_draw_vline_rop(x, SSD1306_HEIGHT - h, h, SSD1306_ROP_SET);
+    }
+
+    cycles[SSD1306_KERNEL_PAGE_BAR] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+
+    for(uint8_t x = 0; x < SSD1306_WIDTH; x++)
+    {
+        ssd1306_column_scroll(-1);
+        ssd1306_column_bar(SSD1306_WIDTH - 1, 1, x * 37 % (SSD1306_HEIGHT + 1));
+    }
+
+    cycles[SSD1306_KERNEL_COLUMN_SCROLL] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+
+    for(uint8_t x = 0; x < SSD1306_WIDTH; x++)
+    {
+        uint8_t h = x * 37 % (SSD1306_HEIGHT + 1);
+
+        // Every page row moves one column left, the last column is drawn again
+        for(uint8_t page = 0; page < SSD1306_BUFFER_PAGES; page++)
+        {
+            uint8_t* row = (uint8_t*)frame + page * SSD1306_WIDTH;
+
+            memmove(row, row + 1, SSD1306_WIDTH - 1);
+        }
+
+        ssd1306_draw_vline_rop(SSD1306_WIDTH - 1, 0, SSD1306_HEIGHT - h, SSD1306_ROP_CLEAR);
+        ssd1306_draw_vline_rop(SSD1306_WIDTH - 1, SSD1306_HEIGHT - h, h, SSD1306_ROP_SET);
+    }
+
+    cycles[SSD1306_KERNEL_PAGE_SCROLL] = ssd1306_get_timestamp() - start;
+
+    // Glyph blitter and bulk copy, run once with and once without SSD1306_USE_RAMFUNC
+    start = ssd1306_get_timestamp();
+
+    for(uint8_t y = 0; y + font11x18.height <= SSD1306_HEIGHT; y += font11x18.height)
+    {
+        ssd1306_set_cursor(0, y);
+        ssd1306_write_string_rop(font11x18, "0123456789", SSD1306_ROP_SET);
+    }
+
+    cycles[SSD1306_KERNEL_GLYPH] = ssd1306_get_timestamp() - start;
+
+    start = ssd1306_get_timestamp();
+    ssd1306_mem_copy(frame, &frame[half], half * 4);
+    cycles[SSD1306_KERNEL_COPY] = ssd1306_get_timestamp() - start;
+}
@@ -0,0 +1,70 @@
+/*
+ * ssd1306_kernel.h
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#ifndef __SSD1306_KERNEL_H__
+#define __SSD1306_KERNEL_H__
+
+
+#include "ssd1306.h"
+
+
+/* SSD1306 Kernel Constant */
+
+// Index into ssd1306_kernel_benchmark() result
+#define SSD1306_KERNEL_FILL         0
+#define SSD1306_KERNEL_INVERT       1
+#define SSD1306_KERNEL_BLEND        2
+#define SSD1306_KERNEL_OR           3
+#define SSD1306_KERNEL_AND          4
+#define SSD1306_KERNEL_XOR          5
+#define SSD1306_KERNEL_SHIFT        6
+#define SSD1306_KERNEL_COMPARE      7
+#define SSD1306_KERNEL_PIXEL        8       // every pixel white then black, SSD1306_USE_BITBAND or mask
+#define SSD1306_KERNEL_SPAN         9       // XOR every row and column with ssd1306_draw_hline/vline_rop()
+#define SSD1306_KERNEL_SPAN_PIXEL   10      // same lines with ssd1306_draw_pixel_rop()
+#define SSD1306_KERNEL_COLUMN_BAR   11      // 128 one column bars with ssd1306_column_bar()
+#define SSD1306_KERNEL_PAGE_BAR     12      // same chart with ssd1306_draw_vline_rop(), clear above and bar
+#define SSD1306_KERNEL_COLUMN_SCROLL 13     // 128 strip chart steps, ssd1306_column_scroll() and a new bar
+#define SSD1306_KERNEL_PAGE_SCROLL  14      // same steps on the page-major buffer, page rows moved and a new bar
+#define SSD1306_KERNEL_GLYPH        15      // "0123456789" in font11x18 on every text row, SSD1306_USE_RAMFUNC or flash
+#define SSD1306_KERNEL_COPY         16      // ssd1306_mem_copy() of half the frame buffer onto the other half
+#define SSD1306_KERNEL_COUNT        17
+
+
+/* SSD1306 Kernel Function */
+
+// Word-wide buffer kernels, 4-byte aligned buffers, size in 32-bit words
+// dst inside the frame buffer : lit count is recounted on next ssd1306_get_lit_pixels()
+
+void ssd1306_kernel_fill(uint32_t* dst, uint32_t pattern, uint16_t words);
+void ssd1306_kernel_invert(uint32_t* dst, uint16_t words);
+
+// dst bits where mask is set come from src
+void ssd1306_kernel_blend(uint32_t* dst, const uint32_t* src, const uint32_t* mask, uint16_t words);
+
+void ssd1306_kernel_or(uint32_t* dst, const uint32_t* src, uint16_t words);
+void ssd1306_kernel_and(uint32_t* dst, const uint32_t* src, uint16_t words);
+void ssd1306_kernel_xor(uint32_t* dst, const uint32_t* src, uint16_t words);
+
+// Vertical shift of page bytes, row r of a page takes row r + bits
+// next : page below, NULL : blank rows come in
+// @param : bits 0 - 7
+void ssd1306_kernel_shift(uint32_t* dst, const uint32_t* page, const uint32_t* next, uint8_t bits, uint16_t words);
+
+// Bytes that differ, UADD8/SEL byte lanes on Cortex-M4, SWAR elsewhere, the only kernel with a SIMD path
+// first, last : byte index of the first and last difference, untouched when equal, may be NULL
+// @return : number of differing bytes
+uint16_t ssd1306_kernel_compare(const uint32_t* a, const uint32_t* b, uint16_t words, uint16_t* first, uint16_t* last);
+
+// Cycles of every kernel over the frame buffer, ssd1306_get_timestamp() units
+// Clobbers the frame buffer
+// @param : SSD1306_KERNEL_COUNT entries
+void ssd1306_kernel_benchmark(uint32_t* cycles);
+
+
+#endif /* __SSD1306_KERNEL_H__ */
@@ -0,0 +1,96 @@
+/*
+ * ssd1306_list.h
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#ifndef __SSD1306_LIST_H__
+#define __SSD1306_LIST_H__
+
+
+#include "ssd1306.h"
+
+
+/* SSD1306 Display List Option */
+
+// Entries in the list, static arena, no heap
+#define SSD1306_LIST_SIZE               16
+
+// Characters per text entry, longer text is cut
+#define SSD1306_LIST_TEXT_SIZE          16
+
+
+/* SSD1306 Display List Constant */
+
+#define SSD1306_LIST_NONE               0
+#define SSD1306_LIST_TEXT               1
+#define SSD1306_LIST_LINE               2
+#define SSD1306_LIST_RECT               3
+#define SSD1306_LIST_BITMAP             4
+
+// One tile is SSD1306_DIRTY_TILE_WIDTH columns of one page
+#define SSD1306_LIST_TILES              (SSD1306_WIDTH / SSD1306_DIRTY_TILE_WIDTH)
+
+
+/* SSD1306 Display List Struct */
+typedef struct
+{
+    uint8_t type;           // SSD1306_LIST_NONE, _TEXT, _LINE, _RECT, _BITMAP
+    uint8_t color;          // SSD1306_WHITE, SSD1306_BLACK : inverted source
+    uint8_t rop;            // SSD1306_ROP_SET after add
+    uint8_t fill;           // rect : 0 outline, 1 filled
+    int16_t x0, y0;         // top left, line : start
+    int16_t x1, y1;         // bottom right, line : end, may lie off the panel
+
+    union
+    {
+        struct
+        {
+            SSD1306_FONT font;
+            char data[SSD1306_LIST_TEXT_SIZE + 1];
+
+        } text;
+
+        const uint8_t* bitmap;  // page-major like the frame buffer, (x1 - x0 + 1) bytes per page, set bits in color
+    };
+
+} SSD1306_LIST_ENTRY;
+
+
+/* SSD1306 Display List Function */
+
+// Add an entry on top of the others, invalidates its tiles
+// @return : handle, -1 when the list is full
+int8_t ssd1306_list_add_text(uint8_t x, uint8_t y, SSD1306_FONT font, const char* text, uint8_t color);
+int8_t ssd1306_list_add_line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color);
+int8_t ssd1306_list_add_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t color, uint8_t fill);
+int8_t ssd1306_list_add_bitmap(uint8_t x, uint8_t y, uint8_t w, uint8_t h, const uint8_t* bitmap);
+
+// Change an entry, invalidates the tiles under its old and new bounding box
+// Same text as before : nothing to redraw
+void ssd1306_list_set_text(int8_t handle, const char* text);
+void ssd1306_list_set_color(int8_t handle, uint8_t color);
+
+// Raster op of the entry onto the entries below it, e.g. SSD1306_ROP_XOR cursor over text
+void ssd1306_list_set_rop(int8_t handle, uint8_t rop);
+
+// Move top left corner (line : start point), size is kept
+void ssd1306_list_move(int8_t handle, uint8_t x, uint8_t y);
+
+void ssd1306_list_remove(int8_t handle);
+void ssd1306_list_clear();
+
+const SSD1306_LIST_ENTRY* ssd1306_list_get(int8_t handle);
+
+// Draw every entry into the buffer, usable as ssd1306_stream_frame() callback
+// Entries are panel coordinates, the current origin and clip do not apply and are kept
+void ssd1306_list_draw(void* context);
+
+// Re-rasterize invalidated tiles and flush them with ssd1306_update_region()
+// Streaming : redraws the whole frame with ssd1306_stream_frame()
+HAL_StatusTypeDef ssd1306_list_render();
+
+
+#endif /* __SSD1306_LIST_H__ */
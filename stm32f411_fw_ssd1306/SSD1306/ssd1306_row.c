@@ -0,0 +1,189 @@
+/*
+ * ssd1306_row.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#include "ssd1306_row.h"
+#include <string.h> // memset
+
+
+/* SSD1306 Row-Major Canvas Variable */
+
+static uint8_t row_buffer[SSD1306_HEIGHT * SSD1306_ROW_STRIDE] __attribute__((aligned(4)));
+static uint16_t row_dirty[SSD1306_PAGE];    // bit g : columns 8g - 8g + 7 of the page changed
+
+
+/* Transpose Kernel */
+// Bit order of every byte reversed, byte order of the word reversed
+static inline uint32_t ssd1306_row_rbit(uint32_t x)
+{
+#if defined(__CORTEX_M)
+    return __RBIT(x);
+#else
+    x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+    x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F) | ((x & 0x0F0F0F0F) << 4);
+
+    return (x >> 24) | ((x >> 8) & 0x0000FF00) | ((x << 8) & 0x00FF0000) | (x << 24);
+#endif
+}
+
+// Hacker's Delight transpose8, rows 0 - 3 in x and 4 - 7 in y, MSB first
+SSD1306_RAM_FUNC void ssd1306_row_transpose8(const uint8_t* src, uint8_t stride, uint8_t* dst)
+{
+    uint32_t x, y, t;
+
+    // Unsigned before shifting, a promoted int must not reach the sign bit
+    x = ((uint32_t)src[0] << 24) | ((uint32_t)src[stride] << 16) | ((uint32_t)src[2 * stride] << 8) | src[3 * stride];
+    y = ((uint32_t)src[4 * stride] << 24) | ((uint32_t)src[5 * stride] << 16) | ((uint32_t)src[6 * stride] << 8) | src[7 * stride];
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA;    x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;    y = y ^ t ^ (t << 7);
+
+    t = (x ^ (x >> 14)) & 0x0000CCCC;   x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC;   y = y ^ t ^ (t << 14);
+
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    // Byte j of x is column j with row 0 in the MSB, page bytes want row 0 in D0 and column 0 first
+    x = ssd1306_row_rbit(x);
+    y = ssd1306_row_rbit(y);
+
+    dst[0] = x;
+    dst[1] = x >> 8;
+    dst[2] = x >> 16;
+    dst[3] = x >> 24;
+    dst[4] = y;
+    dst[5] = y >> 8;
+    dst[6] = y >> 16;
+    dst[7] = y >> 24;
+}
+
+
+/* Row-Major Canvas Function */
+uint8_t* ssd1306_row_get_buffer()
+{
+    return row_buffer;
+}
+
+void ssd1306_row_invalidate()
+{
+    memset(row_dirty, 0xFF, sizeof(row_dirty));
+}
+
+void ssd1306_row_clear()
+{
+    memset(row_buffer, 0x00, sizeof(row_buffer));
+
+    ssd1306_row_invalidate();
+}
+
+SSD1306_RAM_FUNC void ssd1306_row_black_pixel(uint8_t x, uint8_t y)
+{
+    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+        return;
+
+    row_buffer[y * SSD1306_ROW_STRIDE + x / 8] &= ~(0x80 >> (x % 8));
+    row_dirty[y / 8] |= 1 << (x / 8);
+}
+
+SSD1306_RAM_FUNC void ssd1306_row_white_pixel(uint8_t x, uint8_t y)
+{
+    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+        return;
+
+    row_buffer[y * SSD1306_ROW_STRIDE + x / 8] |= 0x80 >> (x % 8);
+    row_dirty[y / 8] |= 1 << (x / 8);
+}
+
+SSD1306_RAM_FUNC void ssd1306_row_hline(uint8_t x0, uint8_t x1, uint8_t y, uint8_t color)
+{
+    uint8_t* row = &row_buffer[y * SSD1306_ROW_STRIDE];
+    uint8_t first, last;
+
+    if(x0 > x1)
+    {
+        uint8_t x = x0;
+
+        x0 = x1;
+        x1 = x;
+    }
+
+    if(x0 >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+        return;
+
+    if(x1 >= SSD1306_WIDTH)
+        x1 = SSD1306_WIDTH - 1;
+
+    first = x0 / 8;
+    last = x1 / 8;
+
+    for(uint8_t i = first; i <= last; i++)
+    {
+        // Edge bytes keep the pixels outside x0 - x1
+        uint8_t mask = 0xFF;
+
+        if(i == first)
+            mask &= 0xFF >> (x0 % 8);
+
+        if(i == last)
+            mask &= 0xFF << (7 - x1 % 8);
+
+        if(color == SSD1306_WHITE)
+            row[i] |= mask;
+        else
+            row[i] &= ~mask;
+    }
+
+    row_dirty[y / 8] |= (uint16_t)((2UL << last) - (1UL << first));
+}
+
+// Blocks with a set bit in mask[page], every block when mask is NULL
+static void ssd1306_row_convert(const uint16_t* mask)
+{
+    for(uint8_t page = 0; page < SSD1306_PAGE; page++)
+    {
+        uint8_t* dst = ssd1306_get_page(page);
+        const uint8_t* src = &row_buffer[page * 8 * SSD1306_ROW_STRIDE];
+        uint8_t block[8] __attribute__((aligned(4)));
+
+        if(dst == NULL || (mask != NULL && mask[page] == 0))
+            continue;
+
+        for(uint8_t g = 0; g < SSD1306_ROW_STRIDE; g++)
+        {
+            if(mask != NULL && !(mask[page] & (1 << g)))
+                continue;
+
+            ssd1306_row_transpose8(&src[g], SSD1306_ROW_STRIDE, block);
+
+            // Lit pixel count follows the copy
+            ssd1306_mem_copy(&dst[g * 8], block, 8);
+        }
+    }
+}
+
+void ssd1306_row_draw(void* context)
+{
+    (void)context;
+
+    ssd1306_row_convert(NULL);
+}
+
+HAL_StatusTypeDef ssd1306_row_update_screen()
+{
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    return ssd1306_stream_frame(ssd1306_row_draw, NULL);
+#else
+    ssd1306_row_convert(row_dirty);
+
+    memset(row_dirty, 0x00, sizeof(row_dirty));
+
+    return ssd1306_update_screen_dirty();
+#endif
+}
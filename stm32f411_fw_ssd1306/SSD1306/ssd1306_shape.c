@@ -0,0 +1,335 @@
+/*
+ * ssd1306_shape.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#include "ssd1306_shape.h"
+
+
+/* Shape Struct */
+// Box x0 - x1, y0 - y1 inclusive with quarter ellipse corners of radius rx, ry
+// Ellipse : corners meet in the middle, rounded rect : straight sides between them
+typedef struct
+{
+    int16_t x0, y0;
+    int16_t x1, y1;
+    uint8_t rx, ry;
+
+} SSD1306_SHAPE;
+
+
+/* Span */
+static uint16_t ssd1306_shape_sqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while(bit > value)
+        bit >>= 2;
+
+    while(bit)
+    {
+        if(value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+// Local coordinates are 0 - 255 like the other drawing functions, the rest is cut here
+static void ssd1306_shape_box(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t rop)
+{
+    if(x < 0)
+    {
+        w += x;
+        x = 0;
+    }
+
+    if(y < 0)
+    {
+        h += y;
+        y = 0;
+    }
+
+    if(w <= 0 || h <= 0 || x > UINT8_MAX || y > UINT8_MAX)
+        return;
+
+    ssd1306_fill_rect_rop(x, y, w < UINT8_MAX ? w : UINT8_MAX, h < UINT8_MAX ? h : UINT8_MAX, NULL, rop);
+}
+
+static void ssd1306_shape_span(int16_t left, int16_t right, int16_t y, uint8_t rop)
+{
+    ssd1306_shape_box(left, y, right - left + 1, 1, rop);
+}
+
+
+/* Shape */
+static void ssd1306_shape_init(SSD1306_SHAPE* shape, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t rx, uint8_t ry)
+{
+    shape->x0 = x0;
+    shape->y0 = y0;
+    shape->x1 = x1;
+    shape->y1 = y1;
+
+    // Corners must not cross, empty box keeps radius 0
+    if(rx > SSD1306_SHAPE_RADIUS_MAX)
+        rx = SSD1306_SHAPE_RADIUS_MAX;
+
+    if(ry > SSD1306_SHAPE_RADIUS_MAX)
+        ry = SSD1306_SHAPE_RADIUS_MAX;
+
+    shape->rx = x1 < x0 ? 0 : (rx < (x1 - x0) / 2 ? rx : (x1 - x0) / 2);
+    shape->ry = y1 < y0 ? 0 : (ry < (y1 - y0) / 2 ? ry : (y1 - y0) / 2);
+}
+
+// Half width of a quarter ellipse d rows from its center row
+// x² ry² + d² rx² <= rx² ry² + rx ry (rx + ry) / 4 : radius plus a quarter pixel, no spikes at the poles
+static uint8_t ssd1306_shape_half_width(uint8_t d, uint8_t rx, uint8_t ry)
+{
+    uint32_t rx2 = (uint32_t)rx * rx;
+    uint32_t ry2 = (uint32_t)ry * ry;
+    uint32_t limit = rx2 * ry2 + (uint32_t)rx * ry * (rx + ry) / 4;
+    uint16_t half;
+
+    if(ry == 0)
+        return rx;
+
+    half = ssd1306_shape_sqrt((limit - d * d * rx2) / ry2);
+
+    return half < rx ? half : rx;
+}
+
+// @return : 0 when row y is outside the shape
+static uint8_t ssd1306_shape_row(const SSD1306_SHAPE* shape, int16_t y, int16_t* left, int16_t* right)
+{
+    uint8_t d = 0;
+    uint8_t inset;
+
+    if(y < shape->y0 || y > shape->y1 || shape->x0 > shape->x1)
+        return 0;
+
+    if(y < shape->y0 + shape->ry)
+        d = shape->y0 + shape->ry - y;
+    else if(y > shape->y1 - shape->ry)
+        d = y - (shape->y1 - shape->ry);
+
+    inset = shape->rx - ssd1306_shape_half_width(d, shape->rx, shape->ry);
+
+    *left = shape->x0 + inset;
+    *right = shape->x1 - inset;
+
+    return 1;
+}
+
+static void ssd1306_shape_fill(const SSD1306_SHAPE* shape, uint8_t rop)
+{
+    int16_t left, right;
+
+    for(int16_t y = shape->y0; y <= shape->y1; y++)
+    {
+        if(ssd1306_shape_row(shape, y, &left, &right))
+            ssd1306_shape_span(left, right, y, rop);
+    }
+}
+
+// Each row runs from its own edge to one short of the narrower neighbour row, 8-connected without overlap
+static void ssd1306_shape_outline(const SSD1306_SHAPE* shape, uint8_t rop)
+{
+    int16_t left, right, above_left, above_right, below_left, below_right;
+
+    for(int16_t y = shape->y0; y <= shape->y1; y++)
+    {
+        int16_t left_end, right_start;
+
+        if(!ssd1306_shape_row(shape, y, &left, &right))
+            continue;
+
+        // Top and bottom rows are solid
+        if(!ssd1306_shape_row(shape, y - 1, &above_left, &above_right) || !ssd1306_shape_row(shape, y + 1, &below_left, &below_right))
+        {
+            ssd1306_shape_span(left, right, y, rop);
+            continue;
+        }
+
+        left_end = (above_left > below_left ? above_left : below_left) - 1;
+        right_start = (above_right < below_right ? above_right : below_right) + 1;
+
+        if(left_end < left)
+            left_end = left;
+
+        if(right_start > right)
+            right_start = right;
+
+        if(left_end >= right_start)
+        {
+            ssd1306_shape_span(left, right, y, rop);
+        }
+        else
+        {
+            ssd1306_shape_span(left, left_end, y, rop);
+            ssd1306_shape_span(right_start, right, y, rop);
+        }
+    }
+}
+
+// Shape minus the same shape width pixels smaller, rows without inner span are solid
+static void ssd1306_shape_ring(const SSD1306_SHAPE* shape, uint8_t width, uint8_t rop)
+{
+    SSD1306_SHAPE inner;
+    int16_t left, right, inner_left, inner_right;
+
+    if(width <= 1)
+    {
+        ssd1306_shape_outline(shape, rop);
+        return;
+    }
+
+    ssd1306_shape_init(&inner, shape->x0 + width, shape->y0 + width, shape->x1 - width, shape->y1 - width,
+                       shape->rx > width ? shape->rx - width : 0, shape->ry > width ? shape->ry - width : 0);
+
+    for(int16_t y = shape->y0; y <= shape->y1; y++)
+    {
+        if(!ssd1306_shape_row(shape, y, &left, &right))
+            continue;
+
+        if(ssd1306_shape_row(&inner, y, &inner_left, &inner_right))
+        {
+            ssd1306_shape_span(left, inner_left - 1, y, rop);
+            ssd1306_shape_span(inner_right + 1, right, y, rop);
+        }
+        else
+        {
+            ssd1306_shape_span(left, right, y, rop);
+        }
+    }
+}
+
+
+/* Line Function */
+void ssd1306_draw_line_thick(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t width)
+{
+    uint8_t rop = ssd1306_get_rop();
+    uint8_t steep = (y1 > y0 ? y1 - y0 : y0 - y1) > (x1 > x0 ? x1 - x0 : x0 - x1);
+
+    // Walk the major axis, minor coordinate in Bresenham error steps
+    int16_t major = steep ? y0 : x0;
+    int16_t minor = steep ? x0 : y0;
+    int16_t end = steep ? y1 : x1;
+    int16_t minor_end = steep ? x1 : y1;
+    int16_t major_step = end >= major ? 1 : -1;
+    int16_t minor_step = minor_end >= minor ? 1 : -1;
+    int16_t major_delta = (end - major) * major_step;
+    int16_t minor_delta = (minor_end - minor) * minor_step;
+    int16_t error = 2 * minor_delta - major_delta;
+    int16_t start = major;
+    int16_t offset = (width - 1) / 2;
+
+    for(;;)
+    {
+        // Run ends where the minor coordinate steps : row run, steep : column run
+        if(major == end || error > 0)
+        {
+            int16_t low = start < major ? start : major;
+            int16_t length = (major - start) * major_step + 1;
+
+            if(steep)
+                ssd1306_shape_box(minor - offset, low, width, length, rop);
+            else
+                ssd1306_shape_box(low, minor - offset, length, width, rop);
+
+            if(major == end)
+                break;
+
+            minor += minor_step;
+            error -= 2 * major_delta;
+            start = major + major_step;
+        }
+
+        error += 2 * minor_delta;
+        major += major_step;
+    }
+}
+
+void ssd1306_draw_line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+    ssd1306_draw_line_thick(x0, y0, x1, y1, 1);
+}
+
+
+/* Circle & Ellipse Function */
+void ssd1306_draw_ellipse_thick(uint8_t x, uint8_t y, uint8_t rx, uint8_t ry, uint8_t width)
+{
+    SSD1306_SHAPE shape;
+
+    ssd1306_shape_init(&shape, x - rx, y - ry, x + rx, y + ry, rx, ry);
+    ssd1306_shape_ring(&shape, width, ssd1306_get_rop());
+}
+
+void ssd1306_draw_ellipse(uint8_t x, uint8_t y, uint8_t rx, uint8_t ry)
+{
+    SSD1306_SHAPE shape;
+
+    ssd1306_shape_init(&shape, x - rx, y - ry, x + rx, y + ry, rx, ry);
+    ssd1306_shape_outline(&shape, ssd1306_get_rop());
+}
+
+void ssd1306_fill_ellipse(uint8_t x, uint8_t y, uint8_t rx, uint8_t ry)
+{
+    SSD1306_SHAPE shape;
+
+    ssd1306_shape_init(&shape, x - rx, y - ry, x + rx, y + ry, rx, ry);
+    ssd1306_shape_fill(&shape, ssd1306_get_rop());
+}
+
+void ssd1306_draw_circle_thick(uint8_t x, uint8_t y, uint8_t r, uint8_t width)
+{
+    ssd1306_draw_ellipse_thick(x, y, r, r, width);
+}
+
+void ssd1306_draw_circle(uint8_t x, uint8_t y, uint8_t r)
+{
+    ssd1306_draw_ellipse(x, y, r, r);
+}
+
+void ssd1306_fill_circle(uint8_t x, uint8_t y, uint8_t r)
+{
+    ssd1306_fill_ellipse(x, y, r, r);
+}
+
+
+/* Rounded Rectangle Function */
+void ssd1306_draw_round_rect_thick(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t r, uint8_t width)
+{
+    SSD1306_SHAPE shape;
+
+    ssd1306_shape_init(&shape, x, y, x + w - 1, y + h - 1, r, r);
+    ssd1306_shape_ring(&shape, width, ssd1306_get_rop());
+}
+
+void ssd1306_draw_round_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t r)
+{
+    SSD1306_SHAPE shape;
+
+    ssd1306_shape_init(&shape, x, y, x + w - 1, y + h - 1, r, r);
+    ssd1306_shape_outline(&shape, ssd1306_get_rop());
+}
+
+void ssd1306_fill_round_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t r)
+{
+    SSD1306_SHAPE shape;
+
+    ssd1306_shape_init(&shape, x, y, x + w - 1, y + h - 1, r, r);
+    ssd1306_shape_fill(&shape, ssd1306_get_rop());
+}
@@ -0,0 +1,314 @@
+/*
+ * hal_stub.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ *  HAL I2C for host tests : every transfer completes at once and is decoded
+ *  into the panel RAM it would leave behind, time runs at bus speed.
+ */
+
+
+#include "hal_stub.h"
+#include <stdio.h>  // printf
+#include <string.h> // memset, memcmp
+
+
+/* HAL Stub Variable */
+I2C_HandleTypeDef hi2c1;
+GPIO_TypeDef hal_stub_gpiob;
+
+uint8_t hal_stub_gddram[SSD1306_PAGE][SSD1306_WIDTH];
+
+uint32_t hal_stub_transactions;
+uint32_t hal_stub_command_bytes;
+uint32_t hal_stub_data_bytes;
+uint32_t hal_stub_time_us;
+uint8_t hal_stub_present = 1;
+
+static uint32_t time_ns;
+
+// Controller address pointer, reset : page addressing, full window
+static uint8_t mode = 0x02;
+static uint8_t column, column_start, column_end = SSD1306_WIDTH - 1;
+static uint8_t page, page_start, page_end = SSD1306_PAGE - 1;
+
+
+/* Controller Model */
+static uint8_t hal_stub_parameters(uint8_t command)
+{
+    switch(command)
+    {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+
+        case 0x21: case 0x22: case 0xA3:
+            return 2;
+
+        // Scroll setup, never sent by the driver
+        case 0x26: case 0x27:
+            return 6;
+
+        default:
+            return 0;
+    }
+}
+
+static void hal_stub_command(const uint8_t* data, uint16_t size)
+{
+    for(uint16_t i = 0; i < size; )
+    {
+        uint8_t command = data[i++];
+        uint8_t count = hal_stub_parameters(command);
+
+        if(i + count > size)
+        {
+            printf("hal_stub: command 0x%02X cut off\n", command);
+            return;
+        }
+
+        if(command == 0x20)
+        {
+            mode = data[i] & 0x03;
+        }
+        else if(command == 0x21)
+        {
+            column = column_start = data[i] & 0x7F;
+            column_end = data[i + 1] & 0x7F;
+        }
+        else if(command == 0x22)
+        {
+            page = page_start = data[i] & 0x07;
+            page_end = data[i + 1] & 0x07;
+        }
+        else if(mode == 0x02 && command >= 0xB0 && command <= 0xB7)
+        {
+            page = command & 0x07;
+        }
+        else if(mode == 0x02 && command <= 0x0F)
+        {
+            column = (column & 0xF0) | command;
+        }
+        else if(mode == 0x02 && command >= 0x10 && command <= 0x1F)
+        {
+            column = (column & 0x0F) | ((command & 0x0F) << 4);
+        }
+
+        i += count;
+    }
+}
+
+static void hal_stub_data(const uint8_t* data, uint16_t size)
+{
+    for(uint16_t i = 0; i < size; i++)
+    {
+        hal_stub_gddram[page][column & 0x7F] = data[i];
+
+        if(mode == 0x00)
+        {
+            // Horizontal : column first, wraps to the next page of the window
+            if(column++ == column_end)
+            {
+                column = column_start;
+                page = page == page_end ? page_start : page + 1;
+            }
+        }
+        else if(mode == 0x01)
+        {
+            // Vertical : page first, wraps to the next column of the window
+            if(page++ == page_end)
+            {
+                page = page_start;
+                column = column == column_end ? column_start : column + 1;
+            }
+        }
+        else if(column < SSD1306_WIDTH - 1)
+        {
+            column++;
+        }
+    }
+}
+
+// Address byte, payload and stop at bus speed
+static HAL_StatusTypeDef hal_stub_transfer(I2C_HandleTypeDef* hi2c, uint8_t control, const uint8_t* data, uint16_t size)
+{
+    time_ns += (1 + 1 + size) * HAL_STUB_BYTE_NS;
+    hal_stub_time_us = time_ns / 1000;
+    hal_stub_transactions++;
+
+    if(!hal_stub_present)
+    {
+        hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+        return HAL_ERROR;
+    }
+
+    hi2c->ErrorCode = 0;
+
+    if(control == SSD1306_CONTROL_BYTE_COMMAND)
+    {
+        hal_stub_command_bytes += size;
+        hal_stub_command(data, size);
+    }
+    else if(control == SSD1306_CONTROL_BYTE_DATA)
+    {
+        hal_stub_data_bytes += size;
+        hal_stub_data(data, size);
+    }
+    else
+    {
+        printf("hal_stub: control byte 0x%02X\n", control);
+        return HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+
+/* HAL Stub Function */
+void hal_stub_reset()
+{
+    memset(hal_stub_gddram, 0x00, sizeof(hal_stub_gddram));
+
+    mode = 0x02;
+    column = column_start = 0;
+    column_end = SSD1306_WIDTH - 1;
+    page = page_start = 0;
+    page_end = SSD1306_PAGE - 1;
+
+    time_ns = 0;
+    hal_stub_time_us = 0;
+    hal_stub_present = 1;
+
+    hal_stub_clear_counters();
+}
+
+void hal_stub_clear_counters()
+{
+    hal_stub_transactions = 0;
+    hal_stub_command_bytes = 0;
+    hal_stub_data_bytes = 0;
+}
+
+uint16_t hal_stub_compare_frame()
+{
+    uint16_t count = 0;
+
+    // Streaming : only the page band in memory
+    for(uint8_t page = 0; page < SSD1306_PAGE; page++)
+    {
+        const uint8_t* frame = ssd1306_get_page(page);
+
+        if(frame == NULL)
+            continue;
+
+        for(uint8_t x = 0; x < SSD1306_WIDTH; x++)
+            count += frame[x] != hal_stub_gddram[page][x];
+    }
+
+    return count;
+}
+
+uint32_t ssd1306_get_timestamp()
+{
+    return hal_stub_time_us;
+}
+
+
+/* HAL Function */
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef* hi2c)
+{
+    (void)hi2c;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef* hi2c)
+{
+    (void)hi2c;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef* hi2c, uint16_t address, uint32_t trials, uint32_t timeout)
+{
+    (void)hi2c;
+    (void)address;
+    (void)trials;
+    (void)timeout;
+
+    return hal_stub_present ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef* hi2c, uint16_t address, uint16_t mem, uint16_t mem_size, uint8_t* data, uint16_t size, uint32_t timeout)
+{
+    (void)address;
+    (void)mem_size;
+    (void)timeout;
+
+    return hal_stub_transfer(hi2c, mem, data, size);
+}
+
+// IT and DMA : the completion interrupt runs right away, before the call returns
+static HAL_StatusTypeDef hal_stub_complete(I2C_HandleTypeDef* hi2c, HAL_StatusTypeDef status)
+{
+    if(status == HAL_OK)
+        ssd1306_i2c_tx_cplt_callback(hi2c);
+    else
+        ssd1306_i2c_error_callback(hi2c);
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef* hi2c, uint16_t address, uint16_t mem, uint16_t mem_size, uint8_t* data, uint16_t size)
+{
+    return hal_stub_complete(hi2c, HAL_I2C_Mem_Write(hi2c, address, mem, mem_size, data, size, 0));
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef* hi2c, uint16_t address, uint16_t mem, uint16_t mem_size, uint8_t* data, uint16_t size)
+{
+    return hal_stub_complete(hi2c, HAL_I2C_Mem_Write(hi2c, address, mem, mem_size, data, size, 0));
+}
+
+// Zero-copy frame, control byte is the first buffer byte
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef* hi2c, uint16_t address, uint8_t* data, uint16_t size, uint32_t timeout)
+{
+    (void)address;
+    (void)timeout;
+
+    return hal_stub_transfer(hi2c, data[0], &data[1], size - 1);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef* hi2c, uint16_t address, uint8_t* data, uint16_t size)
+{
+    return hal_stub_complete(hi2c, HAL_I2C_Master_Transmit(hi2c, address, data, size, 0));
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef* hi2c, uint16_t address, uint8_t* data, uint16_t size)
+{
+    return hal_stub_complete(hi2c, HAL_I2C_Master_Transmit(hi2c, address, data, size, 0));
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef* port, GPIO_InitTypeDef* init)
+{
+    (void)port;
+    (void)init;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state)
+{
+    (void)port;
+    (void)pin;
+    (void)state;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* port, uint16_t pin)
+{
+    (void)port;
+    (void)pin;
+
+    return GPIO_PIN_SET;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return hal_stub_time_us / 1000;
+}
@@ -0,0 +1,51 @@
+/*
+ * hal_stub.h
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ */
+
+
+#ifndef __HAL_STUB_H__
+#define __HAL_STUB_H__
+
+
+#include "ssd1306.h"
+
+
+/* HAL Stub Constant */
+
+// 400 kHz bus, 9 clocks per byte with ACK
+#define HAL_STUB_BYTE_NS        22500
+
+
+/* HAL Stub Variable */
+
+// Panel RAM as the controller would hold it after the recorded transfers
+extern uint8_t hal_stub_gddram[SSD1306_PAGE][SSD1306_WIDTH];
+
+extern uint32_t hal_stub_transactions;
+extern uint32_t hal_stub_command_bytes;
+extern uint32_t hal_stub_data_bytes;
+
+// Simulated time, advanced by every transfer at bus speed
+// ssd1306_get_timestamp() returns it, HAL_GetTick() in ms
+extern uint32_t hal_stub_time_us;
+
+// 0 : address NACK on every transfer and probe
+extern uint8_t hal_stub_present;
+
+
+/* HAL Stub Function */
+
+// Panel back to reset state, counters and clock to 0
+void hal_stub_reset();
+
+// Counters only, panel and clock keep going
+void hal_stub_clear_counters();
+
+// @return : number of bytes that differ between the frame buffer and the recorded panel RAM, pages held in memory only
+uint16_t hal_stub_compare_frame();
+
+
+#endif /* __HAL_STUB_H__ */
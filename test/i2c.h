@@ -0,0 +1,101 @@
+/*
+ * i2c.h
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ *  Host stand-in for the CubeMX i2c.h : HAL types and prototypes the driver uses,
+ *  CMSIS intrinsics as no-ops. hal_stub.c implements them.
+ */
+
+
+#ifndef __I2C_H__
+#define __I2C_H__
+
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+/* HAL Type */
+typedef enum
+{
+    HAL_OK      = 0x00,
+    HAL_ERROR   = 0x01,
+    HAL_BUSY    = 0x02,
+    HAL_TIMEOUT = 0x03
+
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+    uint32_t ErrorCode;
+
+} I2C_HandleTypeDef;
+
+typedef struct
+{
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+
+} GPIO_InitTypeDef;
+
+typedef struct
+{
+    uint32_t ODR;
+
+} GPIO_TypeDef;
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+
+} GPIO_PinState;
+
+#define HAL_I2C_ERROR_AF        0x00000004
+
+#define GPIO_PIN_6              0x0040
+#define GPIO_PIN_7              0x0080
+#define GPIO_MODE_OUTPUT_OD     0x00000011
+#define GPIO_PULLUP             0x00000001
+#define GPIO_SPEED_FREQ_HIGH    0x00000002
+
+#define __weak                  __attribute__((weak))
+
+extern I2C_HandleTypeDef hi2c1;
+extern GPIO_TypeDef hal_stub_gpiob;
+
+#define GPIOB                   (&hal_stub_gpiob)
+
+
+/* HAL Function */
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef* hi2c);
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef* hi2c);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef* hi2c, uint16_t address, uint32_t trials, uint32_t timeout);
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef* hi2c, uint16_t address, uint16_t mem, uint16_t mem_size, uint8_t* data, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef* hi2c, uint16_t address, uint16_t mem, uint16_t mem_size, uint8_t* data, uint16_t size);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef* hi2c, uint16_t address, uint16_t mem, uint16_t mem_size, uint8_t* data, uint16_t size);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef* hi2c, uint16_t address, uint8_t* data, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef* hi2c, uint16_t address, uint8_t* data, uint16_t size);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef* hi2c, uint16_t address, uint8_t* data, uint16_t size);
+
+void HAL_GPIO_Init(GPIO_TypeDef* port, GPIO_InitTypeDef* init);
+void HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* port, uint16_t pin);
+
+uint32_t HAL_GetTick(void);
+
+
+/* CMSIS Intrinsic */
+// Single thread on the host, interrupt masking has nothing to do
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t primask) { (void)primask; }
+static inline void __disable_irq(void) { }
+static inline void __WFI(void) { }
+
+
+#endif /* __I2C_H__ */
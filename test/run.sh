@@ -0,0 +1,31 @@
+#!/bin/sh
+# Host tests : builds the driver with the HAL stub and runs every test_*.c
+# usage : test/run.sh [extra cflags], e.g. -DSSD1306_USE_DIRTY_CRC
+# needs gcc, no board
+
+cd "$(dirname "$0")" || exit 1
+
+CC=${CC:-gcc}
+# Font tables are const data behind the non-const SSD1306_FONT.data pointer
+CFLAGS="-std=gnu99 -Wall -Wno-discarded-qualifiers -I. -I.. $*"
+SOURCES="hal_stub.c $(ls ../ssd1306*.c)"
+BUILD=${BUILD:-build}
+failed=0
+
+mkdir -p "$BUILD"
+
+for test in test_*.c
+do
+    name=$(basename "$test" .c)
+
+    if ! $CC $CFLAGS -o "$BUILD/$name" "$test" $SOURCES
+    then
+        echo "$name : BUILD FAILED"
+        failed=1
+        continue
+    fi
+
+    "$BUILD/$name" || failed=1
+done
+
+exit $failed
@@ -0,0 +1,87 @@
+/*
+ * test_boot.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ *  ssd1306_init_async() to the first flush, boot time on a simulated 400 kHz bus
+ */
+
+
+#include "hal_stub.h"
+#include <stdio.h>
+
+
+static void test_draw(void* context)
+{
+    (void)context;
+
+    ssd1306_set_cursor(0, 0);
+    ssd1306_write_string(font7x10, "Boot");
+}
+
+// @return : init start to the end of the first frame in us, 0 on failure
+static uint32_t test_boot(uint8_t clear_ram)
+{
+    const SSD1306_STATS* stats = ssd1306_get_stats();
+    uint32_t boot_time;
+
+    hal_stub_reset();
+
+    if(ssd1306_init_async(clear_ram) != HAL_OK)
+    {
+        printf("init_async(%u) failed\n", clear_ram);
+        return 0;
+    }
+
+    // Other peripherals would be set up here while the sequence is sent
+    ssd1306_wait_idle();
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    if(ssd1306_stream_frame(test_draw, NULL) != HAL_OK)
+#else
+    test_draw(NULL);
+
+    if(ssd1306_update_screen() != HAL_OK)
+#endif
+    {
+        printf("first flush failed\n");
+        return 0;
+    }
+
+    boot_time = stats->boot_time;
+
+    printf("init_async(%u) : boot time %lu us, first frame done at %lu us, %lu transactions, %lu command + %lu data bytes\n",
+           clear_ram, (unsigned long)boot_time, (unsigned long)hal_stub_time_us, (unsigned long)hal_stub_transactions,
+           (unsigned long)hal_stub_command_bytes, (unsigned long)hal_stub_data_bytes);
+
+    if(boot_time == 0 || boot_time > hal_stub_time_us)
+    {
+        printf("boot time not recorded\n");
+        return 0;
+    }
+
+    if(hal_stub_compare_frame() != 0)
+    {
+        printf("panel RAM differs from the frame buffer\n");
+        return 0;
+    }
+
+    return hal_stub_time_us;
+}
+
+int main()
+{
+    uint32_t skip = test_boot(0);
+    uint32_t clear = test_boot(1);
+
+    // Skipping the RAM clear saves one 1 KB data transaction before the first frame
+    if(skip == 0 || clear == 0 || skip >= clear)
+    {
+        printf("test_boot : FAIL\n");
+        return 1;
+    }
+
+    printf("test_boot : PASS\n");
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ * test_cache.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ *  Screen cache PackBits round trip, arena budget and show to the panel
+ */
+
+
+#include "hal_stub.h"
+#include "ssd1306_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+static uint8_t frame[SSD1306_BUFFER_SIZE];
+
+
+/* Test */
+static void test_pattern(uint8_t* buffer, int mode)
+{
+    for(int i = 0; i < SSD1306_BUFFER_SIZE; i++)
+    {
+        switch(mode)
+        {
+            case 0:     buffer[i] = (i % 3 == 0) ? 0x11 : 0x7E;                          break;
+            case 1:     buffer[i] = rand() % 3;                                          break;
+            case 2:     buffer[i] = (rand() % 8) ? buffer[i > 0 ? i - 1 : 0] : rand();   break;
+            default:    buffer[i] = rand();                                              break;
+        }
+    }
+}
+
+// Runs, literals and mixes of both come back byte for byte and never overrun the arena
+static int test_round_trip()
+{
+    uint8_t* buffer = ssd1306_get_buffer();
+
+    for(int i = 0; i < 2000; i++)
+    {
+        test_pattern(buffer, i % 4);
+        memcpy(frame, buffer, sizeof(frame));
+
+        ssd1306_cache_free(0);
+
+        if(ssd1306_cache_store(0) != HAL_OK)
+        {
+            printf("pattern %d not stored\n", i % 4);
+            return 1;
+        }
+
+        memset(buffer, 0x5A, SSD1306_BUFFER_SIZE);
+        ssd1306_cache_draw((void*)0);
+
+        if(memcmp(buffer, frame, sizeof(frame)) != 0 || ssd1306_cache_get_used() > SSD1306_CACHE_SIZE)
+        {
+            printf("pattern %d differs after draw, %u bytes used\n", i % 4, ssd1306_cache_get_used());
+            return 1;
+        }
+    }
+
+    ssd1306_cache_free(0);
+
+    return 0;
+}
+
+// Text screen codes small, noise only fits raw once and is rejected when the arena is short
+static int test_budget()
+{
+    uint8_t* buffer = ssd1306_get_buffer();
+    uint16_t used;
+
+    memset(buffer, 0, SSD1306_BUFFER_SIZE);
+    ssd1306_set_cursor(0, 0);
+    ssd1306_write_string(font11x18, "Menu");
+    ssd1306_set_cursor(0, 30);
+    ssd1306_write_string(font7x10, "Item 1");
+    memcpy(frame, buffer, sizeof(frame));
+
+    if(ssd1306_cache_store(0) != HAL_OK)
+    {
+        printf("menu not stored\n");
+        return 1;
+    }
+
+    used = ssd1306_cache_get_used();
+    printf("menu screen : %u bytes\n", used);
+
+    if(used >= SSD1306_BUFFER_SIZE / 4)
+        return 1;
+
+    test_pattern(buffer, 3);
+
+    if(ssd1306_cache_store(1) != HAL_ERROR || ssd1306_cache_is_stored(1) || ssd1306_cache_get_used() != used)
+    {
+        printf("noise stored past the arena\n");
+        return 1;
+    }
+
+    // Stored screen reaches the panel
+    memset(buffer, 0, SSD1306_BUFFER_SIZE);
+
+    if(ssd1306_cache_show(0) != HAL_OK || memcmp(buffer, frame, sizeof(frame)) != 0 || hal_stub_compare_frame() != 0)
+    {
+        printf("show differs\n");
+        return 1;
+    }
+
+    ssd1306_cache_free(0);
+
+    return ssd1306_cache_get_used() != 0;
+}
+
+int main()
+{
+    int failed;
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    // Store needs the whole frame in memory
+    printf("test_cache : SKIPPED, page streaming\n");
+    return 0;
+#endif
+
+    hal_stub_reset();
+    ssd1306_init();
+    srand(1);
+
+    failed = test_round_trip();
+    failed |= test_budget();
+
+    printf("test_cache : %s\n", failed ? "FAIL" : "PASS");
+
+    return failed;
+}
@@ -0,0 +1,187 @@
+/*
+ * test_column.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ *  Column-major canvas bars, glyphs and scroll against the page-major drawing functions
+ */
+
+
+#include "hal_stub.h"
+#include "ssd1306_column.h"
+#include <stdio.h>
+#include <string.h>
+
+
+/* Test */
+// @return : pixels that differ between the canvas and the frame buffer
+static int test_compare()
+{
+    const uint64_t* canvas = ssd1306_column_get_buffer();
+    const uint8_t* buffer = ssd1306_get_buffer();
+    int differ = 0;
+
+    for(int x = 0; x < SSD1306_WIDTH; x++)
+        for(int y = 0; y < SSD1306_HEIGHT; y++)
+            differ += ((canvas[x] >> y) & 1) != ((buffer[x + (y / 8) * SSD1306_WIDTH] >> (y % 8)) & 1);
+
+    return differ;
+}
+
+// Canvas copied into the frame buffer pixel by pixel
+static void test_copy()
+{
+    const uint64_t* canvas = ssd1306_column_get_buffer();
+
+    for(int x = 0; x < SSD1306_WIDTH; x++)
+    {
+        for(int y = 0; y < SSD1306_HEIGHT; y++)
+        {
+            if((canvas[x] >> y) & 1)
+                ssd1306_white_pixel(x, y);
+            else
+                ssd1306_black_pixel(x, y);
+        }
+    }
+}
+
+static int test_bar()
+{
+    int differ;
+
+    ssd1306_column_clear();
+    memset(ssd1306_get_buffer(), 0x5A, SSD1306_BUFFER_SIZE);
+
+    // Rows above the bar are cleared as well
+    for(int x = 0; x < SSD1306_WIDTH; x++)
+    {
+        uint8_t h = x * 37 % (SSD1306_HEIGHT + 1);
+
+        ssd1306_column_bar(x, 1, h);
+        ssd1306_draw_vline_rop(x, 0, SSD1306_HEIGHT - h, SSD1306_ROP_CLEAR);
+        ssd1306_draw_vline_rop(x, SSD1306_HEIGHT - h, h, SSD1306_ROP_SET);
+    }
+
+    differ = test_compare();
+
+    if(differ)
+        printf("bars : %d pixels differ\n", differ);
+
+    return differ != 0;
+}
+
+// Opaque cells like ssd1306_write_string_rop() with SSD1306_ROP_SET, cut at the right and bottom edge
+static int test_glyph()
+{
+    static const uint8_t ys[] = { 0, 5, 50, 60 };
+    uint64_t* canvas = ssd1306_column_get_buffer();
+    int failed = 0;
+
+    for(unsigned k = 0; k < sizeof(ys); k++)
+    {
+        char column, page;
+        int differ;
+
+        for(int i = 0; i < SSD1306_WIDTH; i++)
+            canvas[i] = 0x0123456789ABCDEFULL * i;
+
+        test_copy();
+
+        column = ssd1306_column_write_string(110, ys[k], font11x18, "Ag7");
+        ssd1306_set_cursor(110, ys[k]);
+        page = ssd1306_write_string_rop(font11x18, "Ag7", SSD1306_ROP_SET);
+
+        differ = test_compare();
+
+        if(differ || column != page)
+        {
+            printf("glyphs at y %u : %d pixels differ, returned '%c' / '%c'\n", ys[k], differ, column, page);
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
+
+static int test_scroll()
+{
+    uint64_t* canvas = ssd1306_column_get_buffer();
+    int differ = 0;
+
+    for(int i = 0; i < SSD1306_WIDTH; i++)
+        canvas[i] = i + 1;
+
+    ssd1306_column_scroll(-3);
+
+    for(int i = 0; i < SSD1306_WIDTH; i++)
+        differ += canvas[i] != (i < SSD1306_WIDTH - 3 ? (uint64_t)i + 4 : 0);
+
+    for(int i = 0; i < SSD1306_WIDTH; i++)
+        canvas[i] = i + 1;
+
+    ssd1306_column_scroll(5);
+
+    for(int i = 0; i < SSD1306_WIDTH; i++)
+        differ += canvas[i] != (i >= 5 ? (uint64_t)i - 4 : 0);
+
+    // Whole width out
+    ssd1306_column_scroll(-128);
+
+    for(int i = 0; i < SSD1306_WIDTH; i++)
+        differ += canvas[i] != 0;
+
+    if(differ)
+        printf("scroll : %d columns differ\n", differ);
+
+    return differ != 0;
+}
+
+// Canvas sent in vertical addressing mode lands in the panel RAM as drawn
+static int test_update()
+{
+    const uint64_t* canvas = ssd1306_column_get_buffer();
+
+    ssd1306_column_clear();
+    ssd1306_column_bar(10, 20, 40);
+    ssd1306_column_write_string(40, 3, font7x10, "Chart");
+
+    if(ssd1306_column_update_screen() != HAL_OK)
+        return 1;
+
+    for(int x = 0; x < SSD1306_WIDTH; x++)
+    {
+        for(int page = 0; page < SSD1306_PAGE; page++)
+        {
+            if(hal_stub_gddram[page][x] != (uint8_t)(canvas[x] >> (page * 8)))
+            {
+                printf("panel column %d page %d differs\n", x, page);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    int failed;
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    // Page-major reference needs the whole frame
+    printf("test_column : SKIPPED, page streaming\n");
+    return 0;
+#endif
+
+    hal_stub_reset();
+    ssd1306_init();
+
+    failed = test_bar();
+    failed |= test_glyph();
+    failed |= test_scroll();
+    failed |= test_update();
+
+    printf("test_column : %s\n", failed ? "FAIL" : "PASS");
+
+    return failed;
+}
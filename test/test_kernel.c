@@ -0,0 +1,142 @@
+/*
+ * test_kernel.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ *  Buffer kernels : compare against a byte loop, lit count after kernels write the frame buffer
+ */
+
+
+#include "hal_stub.h"
+#include "ssd1306_kernel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define TEST_WORDS      16
+
+
+/* Test */
+static int test_compare()
+{
+    uint32_t a[TEST_WORDS], b[TEST_WORDS];
+
+    for(int i = 0; i < 1000; i++)
+    {
+        uint16_t first = 0xFFFF, last = 0xFFFF, count;
+        uint16_t ref_first = 0xFFFF, ref_last = 0xFFFF, ref_count = 0;
+
+        for(int w = 0; w < TEST_WORDS; w++)
+            a[w] = b[w] = rand();
+
+        // A few bytes changed by any non-zero value, lanes with 0x80 and 0x01 included
+        for(int n = rand() % 6; n > 0; n--)
+            ((uint8_t*)b)[rand() % sizeof(b)] ^= (rand() % 2) ? 0x80 : 1 + rand() % 255;
+
+        for(uint16_t j = 0; j < sizeof(a); j++)
+        {
+            if(((uint8_t*)a)[j] == ((uint8_t*)b)[j])
+                continue;
+
+            if(ref_count++ == 0)
+                ref_first = j;
+
+            ref_last = j;
+        }
+
+        count = ssd1306_kernel_compare(a, b, TEST_WORDS, &first, &last);
+
+        if(count != ref_count || first != ref_first || last != ref_last)
+        {
+            printf("compare : %u bytes %u - %u, expected %u bytes %u - %u\n", count, first, last, ref_count, ref_first, ref_last);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_lit(const char* name)
+{
+    uint16_t count = 0;
+
+    for(int i = 0; i < SSD1306_BUFFER_SIZE; i++)
+        count += __builtin_popcount(ssd1306_get_buffer()[i]);
+
+    if(ssd1306_get_lit_pixels() != count)
+    {
+        printf("%s : lit count %u, recount %u\n", name, ssd1306_get_lit_pixels(), count);
+        return 1;
+    }
+
+    return 0;
+}
+
+// Every kernel writing into the frame buffer leaves a right lit count behind
+static int test_frame()
+{
+    static uint32_t source[TEST_WORDS], mask[TEST_WORDS];
+    uint32_t* frame = (uint32_t*)ssd1306_get_buffer();
+    int failed = 0;
+
+    for(int w = 0; w < TEST_WORDS; w++)
+    {
+        source[w] = rand();
+        mask[w] = rand();
+    }
+
+    ssd1306_kernel_fill(frame, 0x00000000, SSD1306_BUFFER_SIZE / 4);
+    failed |= test_lit("fill");
+
+    ssd1306_fill_rect(10, 10, 50, 30);
+    ssd1306_kernel_fill(&frame[3], 0x5A5A5A5A, TEST_WORDS);
+    failed |= test_lit("fill part");
+
+    ssd1306_get_lit_pixels();
+    ssd1306_kernel_invert(&frame[40], TEST_WORDS);
+    failed |= test_lit("invert");
+
+    ssd1306_kernel_blend(&frame[80], source, mask, TEST_WORDS);
+    failed |= test_lit("blend");
+
+    ssd1306_kernel_or(&frame[100], source, TEST_WORDS);
+    failed |= test_lit("or");
+
+    ssd1306_kernel_and(&frame[120], mask, TEST_WORDS);
+    failed |= test_lit("and");
+
+    ssd1306_kernel_xor(&frame[140], source, TEST_WORDS);
+    failed |= test_lit("xor");
+
+    ssd1306_kernel_shift(&frame[160], &frame[160], &frame[192], 3, TEST_WORDS);
+    failed |= test_lit("shift");
+
+    // Outside the frame buffer : count stays as it is
+    ssd1306_kernel_fill(source, 0xFFFFFFFF, TEST_WORDS);
+    failed |= test_lit("fill outside");
+
+    return failed;
+}
+
+int main()
+{
+    int failed;
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    // Kernels run on the frame buffer
+    printf("test_kernel : SKIPPED, page streaming\n");
+    return 0;
+#endif
+
+    hal_stub_reset();
+    ssd1306_init();
+    srand(7);
+
+    failed = test_compare();
+    failed |= test_frame();
+
+    printf("test_kernel : %s\n", failed ? "FAIL" : "PASS");
+
+    return failed;
+}
@@ -0,0 +1,259 @@
+/*
+ * test_list.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ *  Display list line and rectangle spans against a per pixel reference, origin and clip of the application kept
+ */
+
+
+#include "hal_stub.h"
+#include "ssd1306_list.h"
+#include <stdio.h>
+#include <string.h>
+
+
+static uint8_t reference[SSD1306_BUFFER_SIZE];
+static uint8_t background[SSD1306_BUFFER_SIZE];
+
+
+/* Reference */
+static void test_pixel(int x, int y, uint8_t rop)
+{
+    uint8_t* byte;
+    uint8_t bit;
+
+    if(x < 0 || x >= SSD1306_WIDTH || y < 0 || y >= SSD1306_HEIGHT)
+        return;
+
+    byte = &reference[x + (y / 8) * SSD1306_WIDTH];
+    bit = 1 << (y % 8);
+
+    if(rop == SSD1306_ROP_SET || rop == SSD1306_ROP_OR)
+        *byte |= bit;
+    else if(rop == SSD1306_ROP_XOR)
+        *byte ^= bit;
+    else
+        *byte &= ~bit;
+}
+
+// Lit source pixels only, black entries with SET draw black, transparent ones nothing
+static int test_rop(uint8_t color, uint8_t rop)
+{
+    if(color == SSD1306_WHITE)
+        return rop;
+
+    if(rop == SSD1306_ROP_SET)
+        return SSD1306_ROP_CLEAR;
+
+    if(rop == SSD1306_ROP_INVERT)
+        return SSD1306_ROP_SET;
+
+    return -1;
+}
+
+static void test_line(const SSD1306_LIST_ENTRY* entry, int rop)
+{
+    int x = entry->x0, y = entry->y0;
+    int dx = entry->x1 > x ? entry->x1 - x : x - entry->x1;
+    int dy = entry->y1 > y ? y - entry->y1 : entry->y1 - y;
+    int sx = entry->x1 > x ? 1 : -1;
+    int sy = entry->y1 > y ? 1 : -1;
+    int err = dx + dy;
+
+    for(;;)
+    {
+        test_pixel(x, y, rop);
+
+        if(x == entry->x1 && y == entry->y1)
+            break;
+
+        if(2 * err >= dy)
+        {
+            err += dy;
+            x += sx;
+        }
+
+        if(2 * err <= dx)
+        {
+            err += dx;
+            y += sy;
+        }
+    }
+}
+
+static void test_rect(const SSD1306_LIST_ENTRY* entry, int rop)
+{
+    for(int y = entry->y0; y <= entry->y1; y++)
+    {
+        for(int x = entry->x0; x <= entry->x1; x++)
+        {
+            if(entry->fill || x == entry->x0 || x == entry->x1 || y == entry->y0 || y == entry->y1)
+                test_pixel(x, y, rop);
+        }
+    }
+}
+
+
+/* Test */
+// @return : 0 when ssd1306_list_draw() over the background matches the reference
+static int test_entry(int8_t handle, uint8_t color, uint8_t rop)
+{
+    const SSD1306_LIST_ENTRY* entry = ssd1306_list_get(handle);
+    int mapped = test_rop(color, rop);
+
+    ssd1306_list_set_color(handle, color);
+    ssd1306_list_set_rop(handle, rop);
+
+    memcpy(reference, background, sizeof(reference));
+
+    if(mapped >= 0)
+    {
+        if(entry->type == SSD1306_LIST_LINE)
+            test_line(entry, mapped);
+        else
+            test_rect(entry, mapped);
+    }
+
+    memcpy(ssd1306_get_buffer(), background, sizeof(background));
+    ssd1306_list_draw(NULL);
+
+    if(memcmp(ssd1306_get_buffer(), reference, sizeof(reference)) != 0)
+    {
+        printf("type %u (%d, %d) - (%d, %d) color %u rop %u differs\n", entry->type, entry->x0, entry->y0, entry->x1, entry->y1, color, rop);
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_shapes()
+{
+    static const uint8_t lines[][4] =
+    {
+        { 0, 63, 127, 20 }, { 5, 5, 5, 60 }, { 10, 10, 100, 10 }, { 3, 0, 40, 63 },
+        { 120, 2, 7, 50 }, { 64, 32, 64, 32 }, { 0, 0, 127, 63 }, { 200, 10, 10, 70 },
+    };
+    static const uint8_t rects[][5] =
+    {
+        { 40, 30, 30, 20, 0 }, { 40, 30, 30, 20, 1 }, { 0, 0, 128, 64, 0 }, { 100, 50, 60, 30, 1 },
+        { 10, 10, 1, 1, 0 }, { 20, 20, 2, 9, 0 }, { 30, 5, 9, 2, 0 },
+    };
+    static const uint8_t colors[] = { SSD1306_WHITE, SSD1306_BLACK };
+    int failed = 0;
+
+    for(unsigned i = 0; i < sizeof(lines) / sizeof(lines[0]); i++)
+    {
+        int8_t handle = ssd1306_list_add_line(lines[i][0], lines[i][1], lines[i][2], lines[i][3], SSD1306_WHITE);
+
+        for(int pass = 0; pass < 2; pass++)
+        {
+            for(unsigned c = 0; c < sizeof(colors); c++)
+                for(uint8_t rop = SSD1306_ROP_SET; rop <= SSD1306_ROP_INVERT; rop++)
+                    failed |= test_entry(handle, colors[c], rop);
+
+            // End point keeps its offset, ends up left of and below the panel
+            ssd1306_list_move(handle, 20, 30);
+        }
+
+        ssd1306_list_remove(handle);
+    }
+
+    for(unsigned i = 0; i < sizeof(rects) / sizeof(rects[0]); i++)
+    {
+        int8_t handle = ssd1306_list_add_rect(rects[i][0], rects[i][1], rects[i][2], rects[i][3], SSD1306_WHITE, rects[i][4]);
+
+        for(unsigned c = 0; c < sizeof(colors); c++)
+            for(uint8_t rop = SSD1306_ROP_SET; rop <= SSD1306_ROP_INVERT; rop++)
+                failed |= test_entry(handle, colors[c], rop);
+
+        ssd1306_list_remove(handle);
+    }
+
+    return failed;
+}
+
+// Origin and clip of the application do not move or cut the list, and are still set afterwards
+static int test_view()
+{
+    int16_t x, y;
+    int failed = 0;
+
+    ssd1306_list_add_text(0, 0, font7x10, "12:34", SSD1306_WHITE);
+    ssd1306_list_add_line(0, 63, 127, 20, SSD1306_WHITE);
+    ssd1306_list_add_rect(40, 30, 30, 20, SSD1306_WHITE, 0);
+    ssd1306_list_add_rect(90, 40, 20, 10, SSD1306_WHITE, 1);
+
+    memset(ssd1306_get_buffer(), 0, SSD1306_BUFFER_SIZE);
+    ssd1306_list_draw(NULL);
+    memcpy(reference, ssd1306_get_buffer(), sizeof(reference));
+
+    ssd1306_push_clip(0, 16, 64, 32);
+    ssd1306_set_origin(10, 16);
+
+    memset(ssd1306_get_buffer(), 0, SSD1306_BUFFER_SIZE);
+    ssd1306_list_draw(NULL);
+
+    if(memcmp(ssd1306_get_buffer(), reference, sizeof(reference)) != 0)
+    {
+        printf("list drawn through the application origin and clip\n");
+        failed = 1;
+    }
+
+    ssd1306_get_origin(&x, &y);
+
+    if(x != 10 || y != 16)
+    {
+        printf("origin %d, %d not restored\n", x, y);
+        failed = 1;
+    }
+
+    // Local 60, 0 is panel 70, 16, right of the 64 pixel clip
+    ssd1306_draw_pixel_rop(60, 0, SSD1306_ROP_XOR);
+
+    if(memcmp(ssd1306_get_buffer(), reference, sizeof(reference)) != 0)
+    {
+        printf("application clip not restored\n");
+        failed = 1;
+    }
+
+    ssd1306_reset_clip();
+
+    // Tiles flushed by render match the full draw and reach the panel
+    hal_stub_clear_counters();
+
+    if(ssd1306_list_render() != HAL_OK || hal_stub_compare_frame() != 0)
+    {
+        printf("render differs from the panel\n");
+        failed = 1;
+    }
+
+    ssd1306_list_clear();
+
+    return failed;
+}
+
+int main()
+{
+    int failed;
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    // One page of buffer, the list is drawn by ssd1306_stream_frame()
+    printf("test_list : SKIPPED, page streaming\n");
+    return 0;
+#endif
+
+    hal_stub_reset();
+    ssd1306_init();
+
+    // Every other column lit, spans must keep the pixels around them
+    for(int i = 0; i < SSD1306_BUFFER_SIZE; i++)
+        background[i] = (i & 1) ? 0x5A : 0x00;
+
+    failed = test_shapes();
+    failed |= test_view();
+
+    printf("test_list : %s\n", failed ? "FAIL" : "PASS");
+
+    return failed;
+}
@@ -0,0 +1,183 @@
+/*
+ * test_rop.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ *  Raster ops of pixels, glyphs and bitmaps against a per pixel reference, lit count and XOR restore
+ */
+
+
+#include "hal_stub.h"
+#include <stdio.h>
+#include <string.h>
+
+
+static uint8_t reference[SSD1306_BUFFER_SIZE];
+static uint8_t background[SSD1306_BUFFER_SIZE];
+
+
+/* Reference */
+static void test_pixel(int x, int y, uint8_t source, uint8_t rop)
+{
+    uint8_t* byte;
+    uint8_t bit, d, n;
+
+    if(x < 0 || x >= SSD1306_WIDTH || y < 0 || y >= SSD1306_HEIGHT)
+        return;
+
+    byte = &reference[x + (y / 8) * SSD1306_WIDTH];
+    bit = 1 << (y % 8);
+    d = (*byte & bit) != 0;
+
+    switch(rop)
+    {
+        case SSD1306_ROP_SET:       n = source;         break;
+        case SSD1306_ROP_OR:        n = d | source;     break;
+        case SSD1306_ROP_CLEAR:     n = d & !source;    break;
+        case SSD1306_ROP_XOR:       n = d ^ source;     break;
+        default:                    n = !source;        break;
+    }
+
+    if(n)
+        *byte |= bit;
+    else
+        *byte &= ~bit;
+}
+
+static void test_char(SSD1306_FONT font, char ch, int x, int y, uint8_t rop)
+{
+    for(int i = 0; i < font.height; i++)
+    {
+        uint32_t b = font.data[(ch - 32) * font.height + i];
+
+        for(int j = 0; j < font.width; j++)
+            test_pixel(x + j, y + i, ((b << j) & 0x8000) != 0, rop);
+    }
+}
+
+static void test_bitmap(int x, int y, int w, int h, const uint8_t* bitmap, uint8_t rop)
+{
+    for(int row = 0; row < h; row++)
+        for(int col = 0; col < w; col++)
+            test_pixel(x + col, y + row, (bitmap[(row / 8) * w + col] >> (row % 8)) & 1, rop);
+}
+
+
+/* Test */
+static uint16_t test_count()
+{
+    uint16_t count = 0;
+
+    for(int i = 0; i < SSD1306_BUFFER_SIZE; i++)
+        count += __builtin_popcount(ssd1306_get_buffer()[i]);
+
+    return count;
+}
+
+static void test_start()
+{
+    memcpy(ssd1306_get_buffer(), background, sizeof(background));
+    memcpy(reference, background, sizeof(reference));
+    ssd1306_count_lit_pixels();
+}
+
+// @return : 0 when buffer and lit count match the reference
+static int test_check(const char* name, uint8_t rop)
+{
+    if(memcmp(ssd1306_get_buffer(), reference, sizeof(reference)) != 0)
+    {
+        printf("%s rop %u differs\n", name, rop);
+        return 1;
+    }
+
+    if(ssd1306_get_lit_pixels() != test_count())
+    {
+        printf("%s rop %u lit count %u, recount %u\n", name, rop, ssd1306_get_lit_pixels(), test_count());
+        return 1;
+    }
+
+    return 0;
+}
+
+static int test_ops()
+{
+    static const uint8_t bitmap[3 * 11] =
+    {
+        0x3C, 0x42, 0x81, 0xA5, 0x81, 0x99, 0x42, 0x3C, 0xFF, 0x00, 0x55,
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0xFF, 0xAA, 0x0F,
+        0x03, 0x00, 0x01, 0x02, 0x03, 0x00, 0x01, 0x02, 0x03, 0x00, 0x01,
+    };
+    int failed = 0;
+
+    for(uint8_t rop = SSD1306_ROP_SET; rop <= SSD1306_ROP_INVERT; rop++)
+    {
+        // Pixels, one per page byte bit position
+        test_start();
+
+        for(int i = 0; i < 64; i++)
+        {
+            ssd1306_draw_pixel_rop(i * 2, i, rop);
+            test_pixel(i * 2, i, 1, rop);
+        }
+
+        failed |= test_check("pixel", rop);
+
+        // Glyph cells across page boundaries, opaque ops draw the 0 bits too
+        for(uint8_t y = 0; y < 8; y += 3)
+        {
+            test_start();
+            ssd1306_set_cursor(5, y);
+            ssd1306_write_string_rop(font11x18, "Ag", rop);
+            test_char(font11x18, 'A', 5, y, rop);
+            test_char(font11x18, 'g', 16, y, rop);
+            failed |= test_check("glyph", rop);
+        }
+
+        // 11 x 18 bitmap, 3 source pages over 4 panel pages
+        test_start();
+        ssd1306_draw_bitmap_rop(60, 13, 11, 18, bitmap, rop);
+        test_bitmap(60, 13, 11, 18, bitmap, rop);
+        failed |= test_check("bitmap", rop);
+    }
+
+    return failed;
+}
+
+// Drawing the same text twice with XOR gives the buffer back
+static int test_xor()
+{
+    test_start();
+
+    ssd1306_set_rop(SSD1306_ROP_XOR);
+    ssd1306_set_cursor(40, 20);
+    ssd1306_write_string(font7x10, "xor");
+    ssd1306_set_cursor(40, 20);
+    ssd1306_write_string(font7x10, "xor");
+    ssd1306_set_rop(SSD1306_ROP_SET);
+
+    return test_check("xor twice", SSD1306_ROP_XOR);
+}
+
+int main()
+{
+    int failed;
+
+#if defined(SSD1306_USE_PAGE_STREAMING)
+    // Reference is the whole frame
+    printf("test_rop : SKIPPED, page streaming\n");
+    return 0;
+#endif
+
+    hal_stub_reset();
+    ssd1306_init();
+
+    for(int i = 0; i < SSD1306_BUFFER_SIZE; i++)
+        background[i] = i * 37;
+
+    failed = test_ops();
+    failed |= test_xor();
+
+    printf("test_rop : %s\n", failed ? "FAIL" : "PASS");
+
+    return failed;
+}
@@ -0,0 +1,124 @@
+/*
+ * test_row.c
+ *
+ *  Created on: 2026. 10. 19.
+ *
+ *  Row-major canvas : 8x8 transpose against a bit by bit reference, converted frame in the panel RAM
+ */
+
+
+#include "hal_stub.h"
+#include "ssd1306_row.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Page-major like the panel RAM
+static uint8_t reference[SSD1306_PAGE][SSD1306_WIDTH];
+
+
+/* Test */
+static void test_pixel(uint8_t x, uint8_t y, uint8_t color)
+{
+    if(color == SSD1306_WHITE)
+    {
+        ssd1306_row_white_pixel(x, y);
+        reference[y / 8][x] |= 1 << (y % 8);
+    }
+    else
+    {
+        ssd1306_row_black_pixel(x, y);
+        reference[y / 8][x] &= ~(1 << (y % 8));
+    }
+}
+
+static int test_transpose()
+{
+    uint8_t src[8 * 3];
+    uint8_t dst[8];
+
+    for(int i = 0; i < 1000; i++)
+    {
+        for(unsigned j = 0; j < sizeof(src); j++)
+            src[j] = rand();
+
+        ssd1306_row_transpose8(src, 3, dst);
+
+        // Column c : bit r is row r, MSB of a row byte is column 0
+        for(int c = 0; c < 8; c++)
+        {
+            uint8_t column = 0;
+
+            for(int r = 0; r < 8; r++)
+                column |= ((src[r * 3] >> (7 - c)) & 1) << r;
+
+            if(dst[c] != column)
+            {
+                printf("transpose column %d : %02X, expected %02X\n", c, dst[c], column);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_frame()
+{
+    ssd1306_row_clear();
+
+    for(int i = 0; i < 3000; i++)
+        test_pixel(rand() % SSD1306_WIDTH, rand() % SSD1306_HEIGHT, rand() & 1);
+
+    // Span with partial bytes at both ends, single pixel span
+    ssd1306_row_hline(3, 100, 7, SSD1306_WHITE);
+    ssd1306_row_hline(9, 9, 40, SSD1306_WHITE);
+
+    for(int x = 3; x <= 100; x++)
+        reference[0][x] |= 1 << 7;
+
+    reference[5][9] |= 1;
+
+    if(ssd1306_row_update_screen() != HAL_OK || memcmp(hal_stub_gddram, reference, sizeof(reference)) != 0)
+    {
+        printf("converted frame differs\n");
+        return 1;
+    }
+
+    // Flip one pixel
+    hal_stub_clear_counters();
+    test_pixel(64, 32, (reference[4][64] & 1) ? SSD1306_BLACK : SSD1306_WHITE);
+
+    if(ssd1306_row_update_screen() != HAL_OK || memcmp(hal_stub_gddram, reference, sizeof(reference)) != 0)
+    {
+        printf("one pixel change differs\n");
+        return 1;
+    }
+
+    printf("one pixel change : %lu data bytes\n", (unsigned long)hal_stub_data_bytes);
+
+#if defined(SSD1306_USE_DIRTY_CRC) && !defined(SSD1306_USE_PAGE_STREAMING)
+    // Only the block's tile is sent
+    if(hal_stub_data_bytes != SSD1306_DIRTY_TILE_WIDTH)
+        return 1;
+#endif
+
+    return 0;
+}
+
+int main()
+{
+    int failed;
+
+    hal_stub_reset();
+    ssd1306_init();
+    srand(3);
+
+    failed = test_transpose();
+    failed |= test_frame();
+
+    printf("test_row : %s\n", failed ? "FAIL" : "PASS");
+
+    return failed;
+}